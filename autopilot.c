@@ -0,0 +1,166 @@
+// autopilot.c
+// Autopilot (build with -DAUTOPILOT)
+// - Follows a fixed tour through all 1000 cells (a Hamiltonian cycle):
+//   row 0 left to right from column 1, row 1 right to left, ... row 24 left
+//   to right, then through the right edge onto column 0 and up to row 0
+// - Takes shortcuts toward food: any free neighbour further along the tour,
+//   as long as it does not pass the food or the tail
+// - The body then always lies in tour order from tail to head, so the next
+//   tour cell is free or the tail: the snake never traps itself and can fill
+//   the whole board
+// - A decision looks at four neighbours and the food items: its cost does
+//   not grow with the snake. Every decision is timed with the cycle counter;
+//   each new maximum is shown as "Annnnn" on the HUD row, and shown again
+//   after a new game's clear or when the tail has erased part of it
+
+#ifdef AUTOPILOT
+
+#include "hal.h"
+#include "autopilot.h"
+#include "snake.h"
+#include "food.h"
+#include "render.h"
+
+#define AP_CELLS (MAP_W*MAP_H)
+
+// Tour position of every cell (0..999, split into low/high bytes)
+static HAL_ALIGN(0x100) unsigned char g_tour_lo[AP_CELLS];
+static HAL_ALIGN(0x100) unsigned char g_tour_hi[AP_CELLS];
+
+// Direction from every cell to the next cell of the tour
+static HAL_ALIGN(0x100) unsigned char g_tour_dir[AP_CELLS];
+
+static unsigned char g_tour_built = 0u;
+
+// Largest decision so far, in cycles
+static unsigned long g_cycles_max = 0;
+
+// "Annnnn" must be drawn again at the next decision
+static unsigned char g_stat_lost = 0u;
+
+// Tail cell at the last decision (the cell erased if the tail has moved)
+static Cell g_last_tail = 0u;
+
+// Direction of the tour out of (x,y)
+static Direction tour_step(unsigned char x, unsigned char y) {
+    // Column 0 leads back up to row 0, then right into row 0
+    if (x == 0u) return (y == 0u) ? DIR_RIGHT : DIR_UP;
+    if ((y & 1u) == 0u) {
+        // Even rows run right; the last one wraps into column 0
+        if (x != (unsigned char)(MAP_W - 1)) return DIR_RIGHT;
+        return (y == (unsigned char)(MAP_H - 1)) ? DIR_RIGHT : DIR_DOWN;
+    }
+    // Odd rows run left down to column 1
+    return (x != 1u) ? DIR_LEFT : DIR_DOWN;
+}
+
+// Walk the tour once from (1,0) and number its cells
+static void tour_build(void) {
+    unsigned char x = 1u;
+    unsigned char y = 0u;
+    Cell c = 1u;
+    for (unsigned int i = 0; i < AP_CELLS; ++i) {
+        Direction d = tour_step(x, y);
+        g_tour_lo[c]  = (unsigned char)i;
+        g_tour_hi[c]  = (unsigned char)(i >> 8);
+        g_tour_dir[c] = (unsigned char)d;
+        c = snake_cell_step(c, d, &x, &y);
+    }
+}
+
+void autopilot_init(void) {
+    // The start body (a row running right) already lies in tour order
+    if (!g_tour_built) {
+        tour_build();
+        g_tour_built = 1u;
+    }
+    // The new game clears the screen
+    g_stat_lost = 1u;
+#ifndef VICE_CHECK
+    // The check build runs the counter for the whole session already
+    hal_cycles_start();
+#endif
+}
+
+// Tour position of a cell
+static unsigned int tour_pos(Cell c) {
+    return ((unsigned int)g_tour_hi[c] << 8) | g_tour_lo[c];
+}
+
+// Moves along the tour from tour position 'from' to cell c
+static unsigned int tour_ahead(unsigned int from, Cell c) {
+    unsigned int p = tour_pos(c);
+    if (p < from) p += AP_CELLS;
+    return p - from;
+}
+
+// Is any cell of "Annnnn" under the snake?
+static unsigned char stat_covered(void) {
+    for (Cell c = AUTOPILOT_HUD_X; c <= AUTOPILOT_HUD_X + 5u; ++c) {
+        if (snake_occ_test(c)) return 1u;
+    }
+    return 0u;
+}
+
+void autopilot_move(const Snake* s, Direction* dir) {
+    unsigned long t0 = hal_cycles_read();
+    Cell head = snake_head_cell(s);
+    unsigned int from = tour_pos(head);
+
+    // Shortcuts stop before the tail and at the nearest food
+    Cell tail = snake_tail_cell(s);
+    unsigned int limit = tour_ahead(from, tail);
+    for (unsigned char i = 0; i < (unsigned char)FOOD_MAX; ++i) {
+        Cell f = food_cell(i);
+        if (food_at(f) == (unsigned char)(i + 1u)) {
+            unsigned int a = tour_ahead(from, f);
+            if (a < limit) limit = a + 1u;
+        }
+    }
+
+    // Default: the next tour cell (free, or the tail moving away)
+    Direction best = (Direction)g_tour_dir[head];
+    unsigned int best_a = 1u;
+
+    // Furthest free neighbour within the limit
+    for (unsigned char d = 0; d < 4u; ++d) {
+        Cell n = snake_next_cell(s, (Direction)d);
+        unsigned int a = tour_ahead(from, n);
+        if (a > best_a) {
+            if (a < limit) {
+                if (!snake_occ_test(n)) {
+                    best = (Direction)d;
+                    best_a = a;
+                }
+            }
+        }
+    }
+    *dir = best;
+
+    // Decision cost: show each new maximum
+    unsigned long t = hal_cycles_read() - t0;
+    if (t > g_cycles_max) {
+        g_cycles_max = t;
+        g_stat_lost = 1u;
+    }
+
+    // The tail moved off a cell of "Annnnn" (row 0): the step erased it
+    if (tail != g_last_tail) {
+        if (g_last_tail >= AUTOPILOT_HUD_X) {
+            if (g_last_tail <= AUTOPILOT_HUD_X + 5u) g_stat_lost = 1u;
+        }
+    }
+    g_last_tail = tail;
+
+    // Drawn once the body is off those cells, so no digit covers a segment
+    if (g_stat_lost) {
+        if (!stat_covered()) {
+            t = g_cycles_max;
+            if (t > 0xFFFFul) t = 0xFFFFul;
+            render_draw_stat5(AUTOPILOT_HUD_X, 'A', (unsigned int)t);
+            g_stat_lost = 0u;
+        }
+    }
+}
+
+#endif
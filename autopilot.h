@@ -0,0 +1,24 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+// autopilot.h
+// On-target autopilot for soak and stress runs (build with -DAUTOPILOT).
+// Replaces keyboard/joystick steering: every move asks autopilot_move() for
+// a direction. Games start and restart on their own.
+
+#include "snake.h"
+
+// HUD column of the "Annnnn" decision-cycles stat
+#define AUTOPILOT_HUD_X 12u
+
+#ifdef AUTOPILOT
+
+// Build the tour on the first call; reset per-game state
+void autopilot_init(void);
+
+// Choose the direction of the coming move
+void autopilot_move(const Snake* s, Direction* dir);
+
+#endif
+
+#endif
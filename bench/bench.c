@@ -0,0 +1,327 @@
+// bench.c
+// On-target cycle benchmark for the Snake hot paths.
+// Built from the unmodified game modules (KickC pulls in X.c for each X.h):
+//   cd bench && kickc.bat bench.c -I.. -t c64 -a -o snakebench.prg
+//
+// Each routine is timed with the CIA2 32-bit cycle counter (hal.h) around a
+// single call, with the screen blanked and IRQs off so badlines and the
+// KERNAL IRQ do not add noise. Every case is averaged over BENCH_SAMPLES calls
+// from the same starting state (rebuilt untimed), and the counter's own
+// start/read overhead is subtracted.
+//
+// Results are printed on screen and left in BENCH_RESULT for VICE dumps:
+//   +0  'S' 'N' 'K' 'B'
+//   +4  number of cases
+//   +5  cycles per call for each case, 32-bit little endian, in table order
+
+#include "hal.h"
+#include "snake.h"
+#include "food.h"
+#include "render.h"
+
+// Calls averaged per case (power of two: the average is a shift)
+#define BENCH_SAMPLES       8u
+#define BENCH_SAMPLES_SHIFT 3
+
+// Result block for VICE (bsave $C000-$C0FF)
+#define BENCH_RESULT  ((unsigned char*)0xC000)
+
+// Debug cartridge exit register (VICE -debugcart); a harmless SID mirror
+// write on real hardware
+#define DEBUGCART_EXIT  (*((volatile unsigned char*)0xD7FF))
+
+// First board row used for the test snake: the whole board, so the longest
+// case (990 of 1000 cells) fits. No HUD is drawn while timing
+#define BODY_ROW0  0u
+
+// Routines under test
+#define R_STEP     0u
+#define R_GROW     1u
+#define R_COLLIDE  2u
+#define R_SPAWN    3u
+#define R_DRAW     4u
+#define R_CLOCK    5u
+#define R_CLEAR    6u
+#define R_HITBODY  7u
+#define R_HITTAIL  8u
+
+// Fill levels for food_spawn (cells left free besides the snake)
+#define FILL_NONE     0u
+#define FILL_HALF     1u
+#define FILL_EIGHTH   2u
+#define FILL_LAST4    3u
+
+// One case: routine, snake length, fill level
+// COLLIDE tests a free cell (early out), HITBODY a body cell (collision),
+// HITTAIL the tail cell on a normal step (vacated: no collision)
+#define BENCH_N 19u
+static const unsigned char bench_routine[BENCH_N] = {
+    R_STEP, R_STEP, R_STEP,
+    R_GROW, R_GROW, R_GROW,
+    R_COLLIDE, R_COLLIDE, R_COLLIDE, R_HITBODY, R_HITTAIL,
+    R_SPAWN, R_SPAWN, R_SPAWN, R_SPAWN,
+    R_DRAW, R_DRAW, R_DRAW,
+    R_CLEAR
+};
+static const unsigned int bench_len[BENCH_N] = {
+    16u, 254u, 990u,
+    16u, 254u, 990u,
+    16u, 254u, 990u, 990u, 990u,
+    16u, 16u, 16u, 254u,
+    16u, 254u, 990u,
+    0u
+};
+static const unsigned char bench_fill[BENCH_N] = {
+    FILL_NONE, FILL_NONE, FILL_NONE,
+    FILL_NONE, FILL_NONE, FILL_NONE,
+    FILL_NONE, FILL_NONE, FILL_NONE, FILL_NONE, FILL_NONE,
+    FILL_NONE, FILL_HALF, FILL_LAST4, FILL_EIGHTH,
+    FILL_NONE, FILL_NONE, FILL_NONE,
+    FILL_NONE
+};
+
+// HUD clock cases, timed after the table above: BCD clock [SS, MM, MMhi]
+// drawn from the previous value (digits changed: 1, 2, 4), or after a clear
+#define CLOCK_N 4u
+static const unsigned char clock_prev[CLOCK_N][3] = {
+    { 0x00u, 0x00u, 0x00u }, { 0x09u, 0x00u, 0x00u }, { 0x59u, 0x09u, 0x00u }, { 0x00u, 0x00u, 0x00u }
+};
+static const unsigned char clock_next[CLOCK_N][3] = {
+    { 0x01u, 0x00u, 0x00u }, { 0x10u, 0x00u, 0x00u }, { 0x00u, 0x10u, 0x00u }, { 0x59u, 0x59u, 0x00u }
+};
+// Digits rewritten per case (shown as the case argument)
+static const unsigned char clock_digits[CLOCK_N] = { 1u, 2u, 4u, 5u };
+
+static const char* const routine_name[9] = {
+    "STEP   ", "GROW   ", "COLLIDE", "SPAWN  ", "DRAWALL", "CLOCK  ", "CLEAR  ",
+    "HITBODY", "HITTAIL"
+};
+
+static const char* const fill_name[4] = { "", " F1/2", " F4", " F1/8" };
+
+// Powers of ten for the decimal printer (no 32-bit division)
+static const unsigned long POW10[8] = {
+    10000000ul, 1000000ul, 100000ul, 10000ul, 1000ul, 100ul, 10ul, 1ul
+};
+
+static HAL_ALIGN(0x100) Snake g_snake;
+// Direction of the next serpentine cell after the head (always free)
+static Direction g_fwd;
+static unsigned long g_overhead;
+static unsigned char g_out_row;
+static unsigned long g_res[BENCH_N + CLOCK_N];
+
+/* ------------------------------------------------------------
+   Test states
+------------------------------------------------------------ */
+
+// Serpentine direction out of column x on a row running right (or left)
+static Direction serpentine_dir(unsigned char x, unsigned char right) {
+    if (right) {
+        if (x == (unsigned char)(MAP_W - 1)) return DIR_DOWN;
+        return DIR_RIGHT;
+    }
+    if (x == 0u) return DIR_DOWN;
+    return DIR_LEFT;
+}
+
+// Lay out a snake of 'len' cells as a serpentine from row BODY_ROW0 down
+// (tail first), head last; g_fwd continues the serpentine onto a free cell
+static void build_snake(unsigned int len) {
+    unsigned char x = 0u;
+    unsigned char right = 1u;
+
+    snake_init_at(&g_snake, 0u, BODY_ROW0);
+    for (unsigned int i = 1u; i != len; ++i) {
+        Direction d = serpentine_dir(x, right);
+        snake_step_grow(&g_snake, d);
+        if (d == DIR_DOWN) right = (unsigned char)(1u - right);
+        else if (d == DIR_RIGHT) x++;
+        else x--;
+    }
+    g_fwd = serpentine_dir(x, right);
+}
+
+// Occupy free cells below the snake (from the last cell up) until only
+// 'keep' free cells remain
+static void fill_board(unsigned int keep) {
+    Cell c = (Cell)(MAP_W * MAP_H);
+    while (snake_free_count() > keep) {
+        c = c - 1u;
+        if (!snake_occ_test(c)) snake_occ_set(c);
+    }
+}
+
+// Untimed setup for one case
+static void prepare(unsigned char routine, unsigned int len, unsigned char fill) {
+    if (routine == R_CLEAR) return;
+    if (routine == R_CLOCK) {
+        // 'len' is the clock case; the last case starts from a cleared screen
+        clear_battlefield();
+        if (len != CLOCK_N - 1u) {
+            render_draw_clock(clock_prev[len]);
+            render_flush();
+        }
+        return;
+    }
+    build_snake(len);
+    if (fill == FILL_HALF)   fill_board(snake_free_count() >> 1);
+    if (fill == FILL_EIGHTH) fill_board(snake_free_count() >> 3);
+    if (fill == FILL_LAST4)  fill_board(4u);
+}
+
+// One timed call; returns cycles minus counter overhead
+static unsigned long time_once(unsigned char routine, unsigned char arg) {
+    Cell tail;
+    Cell ahead = snake_next_cell(&g_snake, g_fwd);
+
+    // Collision targets: the head is a body cell that is never the tail
+    if (routine == R_HITBODY) ahead = snake_head_cell(&g_snake);
+    if (routine == R_HITTAIL) ahead = snake_tail_cell(&g_snake);
+
+    hal_cycles_start();
+    if (routine == R_STEP) {
+        snake_step(&g_snake, g_fwd, &tail);
+    } else if (routine == R_GROW) {
+        snake_step_grow(&g_snake, g_fwd);
+    } else if (routine == R_COLLIDE) {
+        snake_will_self_collide_next(&g_snake, ahead, 0u);
+    } else if (routine == R_HITBODY) {
+        snake_will_self_collide_next(&g_snake, ahead, 0u);
+    } else if (routine == R_HITTAIL) {
+        snake_will_self_collide_next(&g_snake, ahead, 0u);
+    } else if (routine == R_SPAWN) {
+        food_spawn(0u);
+    } else if (routine == R_DRAW) {
+        render_draw_snake_full(&g_snake);
+    } else if (routine == R_CLOCK) {
+        render_draw_clock(clock_next[arg]);
+        render_flush();
+    } else {
+        clear_battlefield();
+    }
+    unsigned long t = hal_cycles_read();
+    return t - g_overhead;
+}
+
+// Average of BENCH_SAMPLES calls from the same starting state
+static unsigned long time_case(unsigned char routine, unsigned int len,
+                               unsigned char fill) {
+    unsigned long sum = 0ul;
+    for (unsigned char k = 0u; k != (unsigned char)BENCH_SAMPLES; ++k) {
+        prepare(routine, len, fill);
+        sum += time_once(routine, (unsigned char)len);
+    }
+    return sum >> BENCH_SAMPLES_SHIFT;
+}
+
+/* ------------------------------------------------------------
+   Output
+------------------------------------------------------------ */
+
+// ASCII (uppercase) -> C64 screen code
+static unsigned char ascii_to_screen(unsigned char ch) {
+    unsigned char t = (unsigned char)(ch - (unsigned char)65);
+    if (t <= (unsigned char)25) return (unsigned char)(t + (unsigned char)1);
+    return ch;
+}
+
+static unsigned char print_str(unsigned char x, const char* s) {
+    unsigned char* p = SCREEN + (unsigned int)g_out_row * MAP_W;
+    while (*s) {
+        p[x++] = ascii_to_screen((unsigned char)*s);
+        s++;
+    }
+    return x;
+}
+
+// Decimal, right-aligned in 8 columns ending before column 'x_end'
+static void print_u32(unsigned char x_end, unsigned long v) {
+    unsigned char* p = SCREEN + (unsigned int)g_out_row * MAP_W + (unsigned int)(x_end - 8u);
+    unsigned char lead = 1u;
+    for (unsigned char i = 0u; i != 8u; ++i) {
+        unsigned char d = 0u;
+        while (v >= POW10[i]) { v -= POW10[i]; d++; }
+        if (d != 0u || i == 7u) lead = 0u;
+        p[i] = lead ? (unsigned char)' ' : (unsigned char)('0' + d);
+    }
+}
+
+// Decimal 0..9999, four digits with leading zeros
+static void print_u16(unsigned char x, unsigned int v) {
+    unsigned char* p = SCREEN + (unsigned int)g_out_row * MAP_W + x;
+    unsigned char k = 0u, h = 0u, t = 0u;
+    while (v >= 1000u) { v -= 1000u; k++; }
+    while (v >= 100u)  { v -= 100u;  h++; }
+    while (v >= 10u)   { v -= 10u;   t++; }
+    p[0] = (unsigned char)('0' + k);
+    p[1] = (unsigned char)('0' + h);
+    p[2] = (unsigned char)('0' + t);
+    p[3] = (unsigned char)('0' + v);
+}
+
+static void report(unsigned char idx, unsigned char routine, unsigned int arg,
+                   unsigned char fill, unsigned long cycles) {
+    unsigned char* r = BENCH_RESULT + 5u + (unsigned int)idx * 4u;
+    r[0] = BYTE0(cycles);
+    r[1] = BYTE1(cycles);
+    r[2] = BYTE2(cycles);
+    r[3] = BYTE3(cycles);
+
+    unsigned char x = print_str(0u, routine_name[routine]);
+    if (routine != R_CLEAR) {
+        // Snake length, or digits written for the clock cases
+        print_str(x, routine == R_CLOCK ? " D" : " L");
+        print_u16((unsigned char)(x + 2u), arg);
+        print_str((unsigned char)(x + 6u), fill_name[fill]);
+    }
+    print_u32(40u, cycles);
+    g_out_row++;
+}
+
+/* ------------------------------------------------------------
+   Main
+------------------------------------------------------------ */
+void main(void) {
+    asm { sei }
+
+    // Counter overhead: start immediately followed by read
+    g_overhead = 0ul;
+    hal_cycles_start();
+    g_overhead = hal_cycles_read();
+
+    // Blank the screen: no badline DMA while timing
+    HAL_CONTROL1 &= 0xEF;
+
+    for (unsigned char i = 0u; i != (unsigned char)BENCH_N; ++i) {
+        g_res[i] = time_case(bench_routine[i], bench_len[i], bench_fill[i]);
+    }
+    for (unsigned char m = 0u; m != (unsigned char)CLOCK_N; ++m) {
+        g_res[BENCH_N + m] = time_case(R_CLOCK, m, FILL_NONE);
+    }
+
+    // Results screen
+    clear_battlefield();
+    HAL_CONTROL1 |= 0x10;
+    g_out_row = 0u;
+    print_str(0u, "SNAKE CYCLES PER CALL");
+    g_out_row = 2u;
+
+    unsigned char* r = BENCH_RESULT;
+    r[0] = 'S';
+    r[1] = 'N';
+    r[2] = 'K';
+    r[3] = 'B';
+    r[4] = (unsigned char)(BENCH_N + CLOCK_N);
+
+    for (unsigned char i = 0u; i != (unsigned char)BENCH_N; ++i) {
+        report(i, bench_routine[i], bench_len[i], bench_fill[i], g_res[i]);
+    }
+    for (unsigned char m = 0u; m != (unsigned char)CLOCK_N; ++m) {
+        report((unsigned char)(BENCH_N + m), R_CLOCK, clock_digits[m], FILL_NONE, g_res[BENCH_N + m]);
+    }
+
+    // Let VICE save the block and exit; real hardware just shows the table
+    DEBUGCART_EXIT = 0u;
+    while (1) ;
+}
@@ -0,0 +1,28 @@
+#!/bin/sh
+# results.sh <result.bin>
+# Prints the bench result block saved from VICE with bsave (raw memory):
+# magic "SNKB", case count, then 32-bit cycles per call in bench.c table order.
+
+set -eu
+
+BIN=$1
+
+# bsave writes raw memory (no load address): exactly $C000-$C0FF
+SIZE=$(wc -c < "$BIN")
+if [ "$SIZE" -ne 256 ]; then
+    echo "FAIL: $BIN is $SIZE bytes, expected 256 (raw \$C000-\$C0FF)"
+    exit 1
+fi
+
+if [ "$(head -c 4 "$BIN")" != "SNKB" ]; then
+    echo "FAIL: result block magic missing"
+    exit 1
+fi
+
+N=$(od -An -tu1 -j4 -N1 "$BIN" | tr -d ' ')
+i=0
+while [ "$i" -lt "$N" ]; do
+    C=$(od -An -tu4 -j$((5 + i * 4)) -N4 "$BIN" | tr -d ' ')
+    echo "case $i cycles $C"
+    i=$((i + 1))
+done
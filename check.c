@@ -0,0 +1,140 @@
+// check.c
+// Fixed input session for the headless VICE check (-DVICE_CHECK).
+// - Scripted key matrix (start, steering taps, pause, restarts)
+// - 16-bit Galois LFSR in place of SID voice 3 (same food every run)
+// - CIA2 cycle count from the first frame to the last
+// - Screen, colour RAM and results copied to CHECK_DUMP, then exit via $D7FF
+
+#include "hal.h"
+
+#ifdef VICE_CHECK
+
+#include "check.h"
+#include "render.h"
+
+// Debug cartridge exit register (VICE -debugcart)
+#define DEBUGCART_EXIT  (*((volatile unsigned char*)0xD7FF))
+
+// Opening script: keys held from the given frame until the next entry
+// (0xFF = no key). Starts a game, steers a few corners, pauses and resumes.
+#define CHECK_SCRIPT_N 12u
+static const unsigned int check_script_frame[CHECK_SCRIPT_N] = {
+    30u, 34u, 90u, 94u, 150u, 154u, 230u, 234u, 300u, 304u, 400u, 404u
+};
+static const unsigned char check_script_key[CHECK_SCRIPT_N] = {
+    KEY_SPACE, 0xFF, KEY_S, 0xFF, KEY_A, 0xFF, KEY_P, 0xFF, KEY_SPACE, 0xFF, KEY_W, 0xFF
+};
+
+// After the script: a direction tap every 40 frames (turning clockwise), and
+// SPACE every 256 frames to restart once a game is over
+static const unsigned char check_turns[4] = { KEY_D, KEY_S, KEY_A, KEY_W };
+
+// Held key matrix: one byte per row, set bit = key down
+static unsigned char g_keys[8];
+
+static unsigned int  g_frame = 0u;
+static unsigned char g_script_pos = 0u;
+static unsigned char g_turn_div = 0u;
+static unsigned char g_turn = 0u;
+static unsigned char g_space_div = 0u;
+static unsigned int  g_lfsr = 0xACE1u;
+
+static void keys_clear(void) {
+    for (unsigned char r = 0u; r < 8u; ++r) g_keys[r] = 0u;
+}
+
+static void key_down(unsigned char key) {
+    g_keys[key >> 3] |= (unsigned char)(1u << (key & 7u));
+}
+
+// Advance the scripted keys by one frame
+static void script_step(void) {
+    if (g_script_pos < (unsigned char)CHECK_SCRIPT_N) {
+        if (g_frame == check_script_frame[g_script_pos]) {
+            keys_clear();
+            unsigned char key = check_script_key[g_script_pos];
+            if (key != 0xFFu) key_down(key);
+            g_script_pos++;
+        }
+        return;
+    }
+
+    keys_clear();
+    if (++g_turn_div == 40u) {
+        g_turn_div = 0u;
+        key_down(check_turns[g_turn]);
+        g_turn = (unsigned char)((g_turn + 1u) & 3u);
+    }
+    // Held for a few frames, like a real tap
+    if (++g_space_div < 4u) key_down(KEY_SPACE);
+}
+
+// Copy screen, colour RAM and the result block to CHECK_DUMP
+static void check_dump(unsigned long cycles) {
+    // The shown screen: with -DSCREEN_DOUBLE that may be $8400
+    unsigned char* scr = SCREEN_SHOWN;
+    unsigned char* col = HAL_COLOR_RAM;
+    unsigned char* d = CHECK_DUMP;
+    for (unsigned int i = 0u; i < 1000u; ++i) {
+        d[i] = scr[i];
+        d[i + 1000u] = col[i] & 0x0Fu;
+    }
+
+    unsigned char* r = CHECK_RESULT;
+    r[0] = 'S';
+    r[1] = 'N';
+    r[2] = 'K';
+    r[3] = '1';
+    r[CHECK_RES_FRAMES + 0u] = BYTE0(g_frame);
+    r[CHECK_RES_FRAMES + 1u] = BYTE1(g_frame);
+    r[CHECK_RES_CYCLES + 0u] = BYTE0(cycles);
+    r[CHECK_RES_CYCLES + 1u] = BYTE1(cycles);
+    r[CHECK_RES_CYCLES + 2u] = BYTE2(cycles);
+    r[CHECK_RES_CYCLES + 3u] = BYTE3(cycles);
+}
+
+void check_frame(void) {
+    if (g_frame == 0u) hal_cycles_start();
+
+    if (g_frame == CHECK_FRAMES) {
+        check_dump(hal_cycles_read());
+        check_exit(0u);
+    }
+
+    script_step();
+    g_frame++;
+}
+
+void check_exit(unsigned char code) {
+    DEBUGCART_EXIT = code;
+    // Not reached under VICE; park the CPU on real hardware
+    while (1) ;
+}
+
+/* ------------------------------------------------------------
+   hal.h input/RNG implementation for the check build
+------------------------------------------------------------ */
+
+void hal_rnd_init(void) {
+    g_lfsr = 0xACE1u;
+}
+
+unsigned char hal_rnd(void) {
+    // Galois LFSR, taps 16 14 13 11 (maximal length)
+    unsigned char lsb = BYTE0(g_lfsr) & 1u;
+    g_lfsr >>= 1;
+    if (lsb) g_lfsr ^= 0xB400u;
+    return BYTE0(g_lfsr);
+}
+
+unsigned char hal_kbd_read(unsigned char rows) {
+    unsigned char cols = 0u;
+    unsigned char bit = 1u;
+    for (unsigned char r = 0u; r < 8u; ++r) {
+        if ((rows & bit) == 0u) cols |= g_keys[r];
+        bit <<= 1;
+    }
+    return cols ^ 0xFFu;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+// check.h
+// Headless VICE check session (build with -DVICE_CHECK, see vice/).
+// Replaces keyboard and SID random input with a fixed session so every run of
+// the same PRG plays the same games, then stops the emulator after
+// CHECK_FRAMES frames with the screen and the measurements in a dump block.
+
+// Frames to run before exiting (PAL: 3000 = one minute)
+#ifndef CHECK_FRAMES
+#define CHECK_FRAMES 3000u
+#endif
+
+// Dump block read back by the VICE monitor (vice/check.sh)
+// $C000 screen codes (1000), $C3E8 colour RAM low nibbles (1000), $C7D0 result
+#define CHECK_DUMP      ((unsigned char*)0xC000)
+#define CHECK_RESULT    ((unsigned char*)0xC7D0)
+
+// Result block layout
+// +0  'S' 'N' 'K' '1'
+// +4  frames run (16-bit, little endian)
+// +6  CPU cycles over those frames (32-bit, little endian)
+#define CHECK_RES_FRAMES  4u
+#define CHECK_RES_CYCLES  6u
+
+// Called once per frame from hal_wait_raster_wrap(): advances the scripted
+// keys and exits the emulator once CHECK_FRAMES have run
+void check_frame(void);
+
+// Write the exit code to the VICE debug cartridge ($D7FF, -debugcart)
+void check_exit(unsigned char code);
+
+#endif
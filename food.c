@@ -1,15 +1,34 @@
 // food.c
 // - SID-based RNG + food spawning helper for Snake
 // - RNG uses SID voice 3 and initializes on first use
-// - Food is spawned only on unoccupied cells
+// - Food pool (FOOD_MAX items) with a per-cell marker layer for O(1) eat lookup
+// - Food is spawned only on unoccupied cells (drawn from the free-cell pool)
 // - All comments live on their own line above the code they explain
 
-#include <c64.h>
+#include "hal.h"
 #include "food.h"
 #include "render.h"
 #include "hunger.h"
-#include "hud.h"
+#include "replay.h"
 
+#ifdef REPLAY
+// Replay builds draw food from a seeded 16-bit Galois LFSR, so the seed
+// logged with a recording reproduces every spawn (see replay.h)
+static uint16_t g_lfsr = 1u;
+
+void food_rng_seed(uint16_t seed) {
+    if (seed == 0u) seed = 1u;
+    g_lfsr = seed;
+}
+
+uint8_t rng8(void) {
+    // Taps 16 14 13 11 (maximal length)
+    uint8_t lsb = (uint8_t)g_lfsr & 1u;
+    g_lfsr >>= 1;
+    if (lsb) g_lfsr ^= 0xB400u;
+    return (uint8_t)g_lfsr;
+}
+#else
 // Tracks whether SID RNG has been initialized (0 = no, 1 = yes)
 static unsigned char g_rng_inited = 0;
 
@@ -18,73 +37,145 @@ static unsigned char g_rng_inited = 0;
 uint8_t rng8(void) {
     if(!g_rng_inited) {
         // One-time init of SID voice 3 RNG
-        sid_rnd_init();
+        hal_rnd_init();
         g_rng_inited = 1;
     }
     // Fetch a random byte from SID
-    return (uint8_t)sid_rnd();
+    return hal_rnd();
+}
+#endif
+
+// Random value in [0 .. n-1] for n >= 1 in bounded time (no reroll loop)
+// Masks a 16-bit random down to the next power of two, then folds once
+static uint16_t rng_below(uint16_t n) {
+    uint16_t lim = n - 1u;
+    uint16_t mask = 0u;
+    while (mask < lim) mask = (mask << 1) | 1u;
+
+    uint16_t r = rng8();
+    r = (r << 8) | rng8();
+    r &= mask;
+    if (r >= n) r -= n;
+    return r;
 }
 
-// Reduce v into the range [0 .. limit-1] using repeated subtraction
-// This avoids division/modulo and is fragment-friendly
-static uint8_t wrap_under(uint8_t v, uint8_t limit) {
-    while (v >= limit) v -= limit;
-    return v;
+/* ------------------------------------------------------------
+   Food pool
+   - g_food_cell/type/ttl[slot] : item in each slot (ttl 0 = no expiry)
+   - g_food_on[slot]            : 1 while the slot has an item out
+   - g_food_at[cell]            : marker layer, slot + 1 or FOOD_NONE
+   Items are kept out of the free-cell pool, so a spawn never picks a cell
+   that already holds food.
+------------------------------------------------------------ */
+static HAL_ALIGN(0x100) uint8_t g_food_at[MAP_W*MAP_H];
+static Cell    g_food_cell[FOOD_MAX];
+static uint8_t g_food_type[FOOD_MAX];
+static uint8_t g_food_ttl[FOOD_MAX];
+static uint8_t g_food_on[FOOD_MAX];
+static uint8_t g_food_n = 0;
+
+uint8_t food_at(Cell c) { return g_food_at[c]; }
+
+uint8_t food_count(void) { return g_food_n; }
+
+Cell food_cell(uint8_t slot) { return g_food_cell[slot]; }
+
+uint8_t food_type(uint8_t slot) { return g_food_type[slot]; }
+
+// Pick a random free cell for 'slot' and mark it
+// One draw from the free-cell pool, so the cost does not grow as the board fills
+// (the pool already excludes snake, HUD and food cells). A full board leaves
+// the slot empty.
+void food_spawn(uint8_t slot) {
+    uint16_t n = snake_free_count();
+    if (n == 0u) return;
+
+    Cell c = snake_free_cell(rng_below(n));
+    snake_free_take(c);
+    g_food_at[c] = (uint8_t)(slot + 1u);
+
+    // Slot 0 is plain food that stays; the others are bonus food
+    uint8_t type = FOOD_PLAIN;
+    uint8_t ttl  = 0u;
+    if (slot != 0u) {
+        type = FOOD_BONUS;
+        ttl  = FOOD_BONUS_TTL;
+    }
+    g_food_cell[slot] = c;
+    g_food_type[slot] = type;
+    g_food_ttl[slot]  = ttl;
+    if (!g_food_on[slot]) {
+        g_food_on[slot] = 1u;
+        g_food_n++;
+    }
 }
 
-// Pick a random free cell and store it into f->x/f->y
-// Re-rolls until a cell not occupied by the snake or HUD is found
-static void spawn_once(Food* f, const Snake* s) {
-    uint8_t x, y;
-    do {
-        x = wrap_under(rng8(), MAP_W);
-        y = wrap_under(rng8(), MAP_H);
-    } while (snake_occ_test(x, y) || hud_covers_cell(x, y));
-    f->x = x;
-    f->y = y;
+// Empty 'slot': clear its marker (the cell itself is handled by the caller)
+static void food_clear_slot(uint8_t slot) {
+    g_food_at[g_food_cell[slot]] = FOOD_NONE;
+    g_food_on[slot] = 0u;
+    g_food_n--;
 }
 
-// Respawn food at a new free cell (does not draw it)
-void food_spawn(Food* f, const Snake* s) {
-    spawn_once(f, s);
+// Spawn into 'slot' and queue its glyph
+static void food_spawn_draw(uint8_t slot) {
+    food_spawn(slot);
+    if (g_food_on[slot]) render_draw_food(g_food_cell[slot], g_food_type[slot]);
 }
 
-// Initialize RNG stirring + spawn first food, then draw it
+// Clear what the last game left, stir the RNG, then fill every slot
 // Discards a handful of RNG bytes so first values differ across runs
-void food_init(Food* f, const Snake* s) {
+void food_init(void) {
     unsigned char i;
 
-    // Stir the RNG a bit to decorrelate initial state across resets
-    for(i = 0; i < 16; i++) rng8();
+    // Markers of the previous game (the free pool was rebuilt by snake_init)
+    for (i = 0; i < (unsigned char)FOOD_MAX; i++) {
+        if (g_food_on[i]) food_clear_slot(i);
+    }
 
-    // Choose a free cell
-    spawn_once(f, s);
+    // Stir the RNG a bit to decorrelate initial state across resets
+    for (i = 0; i < 16; i++) rng8();
 
-    // Draw the newly spawned food
-    render_draw_food(f->x, f->y);
+    // Choose free cells and draw the food
+    for (i = 0; i < (unsigned char)FOOD_MAX; i++) food_spawn_draw(i);
 }
 
 // Handle eating food WITH growth:
 // - Grow step (tail not removed)
 // - Hunger reset and calm border
 // - Respawn and draw new food
-void food_handle_eat_grow(Snake* s, Direction dir, Food* food) {
-    unsigned char nx, ny;
-
-    // Precompute next head cell
-    snake_next_xy(s, dir, &nx, &ny);
+void food_handle_eat_grow(Snake* s, Direction dir, uint8_t slot) {
+    // The head takes over the cell: it stays out of the free pool
+    food_clear_slot(slot);
 
     // Grow by one segment (updates occupancy, does NOT erase tail)
     snake_step_grow(s, dir);
 
-    // Draw only the new head at nx,ny (no tail erase)
-    render_apply_grow(nx, ny);
+    // Draw only the new head (no tail erase)
+    render_apply_grow(snake_head_cell(s));
 
     // Reset hunger & border
     hunger_reset_on_feed();
 
-    // Respawn food on a free cell and draw it
-    food_spawn(food, s);
-    render_draw_food(food->x, food->y);
+    // Respawn food on a free cell and draw it (board full: slot stays empty,
+    // the game loop ends the game as won once no food is left)
+    food_spawn_draw(slot);
 }
 
+// Age bonus food; expired items go back to the pool and respawn elsewhere.
+// Empty slots (board was full) are retried.
+void food_tick(void) {
+    for (uint8_t i = 0; i < (uint8_t)FOOD_MAX; i++) {
+        if (!g_food_on[i]) {
+            food_spawn_draw(i);
+        } else if (g_food_ttl[i] != 0u) {
+            if (--g_food_ttl[i] == 0u) {
+                Cell c = g_food_cell[i];
+                food_clear_slot(i);
+                snake_free_give(c);
+                render_erase_cell(c);
+                food_spawn_draw(i);
+            }
+        }
+    }
+}
@@ -5,30 +5,61 @@
 #include "snake.h"
 #include "render.h"
 
-// A single food item on the grid
-typedef struct {
-    uint8_t x;
-    uint8_t y;
-} Food;
-
-// Initialize food system:
-// - Stir the SID RNG so first values differ across runs
-// - Spawn the first food on a free cell
+// Food pool size: items out at once (1..16). Slot 0 is always plain food;
+// the other slots hold bonus food that moves on after a while.
+#ifndef FOOD_MAX
+#define FOOD_MAX 1u
+#endif
+
+// Food types
+#define FOOD_PLAIN   0u
+#define FOOD_BONUS   1u
+
+// Bonus food lifetime in game seconds (then it respawns elsewhere)
+#ifndef FOOD_BONUS_TTL
+#define FOOD_BONUS_TTL 8u
+#endif
+
+// food_at() result for a cell without food
+#define FOOD_NONE    0u
+
+// Initialize the food pool for a new game:
+// - Stir the RNG so first values differ across runs
+// - Spawn every slot on a free cell
 // - Draw the food
-void food_init(Food* f, const Snake* s);
+void food_init(void);
 
-// Respawn food at a new random free cell
+// Food lookup: slot + 1 of the item on cell c, or FOOD_NONE.
+// One read of the per-cell marker layer, however many items are out.
+uint8_t food_at(Cell c);
+
+// Spawn food of the slot's type at a random free cell (bounded time: one
+// pick from the free-cell pool). Leaves the slot empty if the board is full.
 // Note: does not draw; caller may draw after moving/animating
-void food_spawn(Food* f, const Snake* s);
+void food_spawn(uint8_t slot);
+
+// Items currently on the board
+uint8_t food_count(void);
+
+// Cell and type of an occupied slot
+Cell food_cell(uint8_t slot);
+uint8_t food_type(uint8_t slot);
 
-// Handle eating food WITH growth:
+// Handle eating the food in 'slot' WITH growth:
 // - Grow step (tail not removed)
 // - Hunger reset and calm border
-// - Respawn and draw new food
-void food_handle_eat_grow(Snake* s, Direction dir, Food* food);
+// - Respawn and draw new food in the same slot
+void food_handle_eat_grow(Snake* s, Direction dir, uint8_t slot);
+
+// Once per game second: age bonus food, move expired items, refill empty
+// slots (at most FOOD_MAX items, never per move)
+void food_tick(void);
 
 // Return a random 8-bit value using SID voice 3
 // Initializes the SID RNG on first call
 uint8_t rng8(void);
 
+// Replay builds only: seed the food RNG for the coming game
+void food_rng_seed(uint16_t seed);
+
 #endif
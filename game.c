@@ -0,0 +1,217 @@
+// game.c
+// One game session for C64 Snake
+// - Sets up snake, food, timer, hunger and pause state
+// - Runs the per-frame loop: input -> pause -> movement/collision/eat -> HUD
+// - Returns on game over (collision or starvation) after drawing the Game Over screen
+
+#include "hal.h"
+#include "game.h"
+#include "input.h"
+#include "snake.h"
+#include "render.h"
+#include "timer.h"
+#include "food.h"
+#include "sys.h"
+#include "hud.h"
+#include "hunger.h"
+#include "pause.h"
+#include "profile.h"
+#include "replay.h"
+#include "autopilot.h"
+
+// Most moves made in one frame (the turbo tier needs 2 at 100 moves/s)
+#ifndef MOVES_PER_FRAME_MAX
+#define MOVES_PER_FRAME_MAX 4u
+#endif
+
+#ifdef RENDER_STATS
+// Longest frame of movement work so far, in raster lines
+static unsigned char g_move_lines_max = 0u;
+
+// Record the raster lines spent on this frame's moves (from line0 to now);
+// a new maximum is shown as "Mnn" next to the flush stats
+static void move_stats(unsigned int line0) {
+    unsigned int line1 = hal_raster_line();
+    if (line1 < line0) line1 += 312u;
+    unsigned int lines = line1 - line0;
+    if (lines > 99u) lines = 99u;
+    if ((unsigned char)lines > g_move_lines_max) {
+        g_move_lines_max = (unsigned char)lines;
+        render_draw_stat(29, 'M', g_move_lines_max);
+    }
+}
+#endif
+
+// The snake lives at file scope so it can be page-aligned: its body arrays
+// then each start on a page (see snake.h)
+static HAL_ALIGN(0x100) Snake g_snake;
+
+/* --------------------------------------
+   Run one full game until collision.
+   Returns when game over, with final time.
+-------------------------------------- */
+void game_loop(void) {
+    Direction dir = DIR_RIGHT;
+
+    input_init();
+    snake_init(&g_snake);
+#ifdef AUTOPILOT
+    autopilot_init();
+#endif
+    render_clear();
+    render_draw_snake_full(&g_snake);
+    render_present();
+    // wall time = 0
+    timer_reset();
+    // full hunger + calm border
+    hunger_init();
+    // paused=0, clock=0
+    pause_reset();
+    render_draw_clock(game_clock());
+
+#ifdef REPLAY
+    // Same seed as the recording (play) or a fresh logged one (record)
+    food_rng_seed(replay_begin());
+#endif
+    food_init();
+
+    // Movement pacing: 8.8 fixed-point rate added to an accumulator each frame
+    {
+        HAL_ZP unsigned int move_rate = MOVE_RATE_START;
+        HAL_ZP unsigned int move_acc  = 0u;
+
+        while (1) {
+            frame_sync_and_input(&dir);
+
+            // Host builds stop after their frame budget (always 0 on the C64)
+            if (hal_quit_requested()) return;
+
+            // --- Pause / Unpause: P pauses, SPACE resumes ---
+            if (!pause_is_paused()) {
+                if (input_pause_press()) {
+                    pause_begin();
+                    // calm border while paused
+                    HAL_BORDER = 14u;
+                    render_show_pause();
+                }
+            } else {
+                if (input_unpause_press()) {
+                    pause_end_and_account();
+
+                    // Instant visual refresh on resume: restores snake, food and HUD
+                    render_hide_pause();
+                    hunger_apply_border_now();
+
+                    // Clear any pending second-edge so we don't insta-tick
+                    pause_drain_second_edge();
+                }
+            }
+
+            // --- Movement & collisions (disabled while paused) ---
+            // One move per whole unit in the accumulator, at most
+            // MOVES_PER_FRAME_MAX per frame (each with its own collision,
+            // eat and render step)
+            if (!pause_is_paused()) {
+                unsigned char moves = 0u;
+#ifdef RENDER_STATS
+                unsigned int line0 = hal_raster_line();
+#endif
+                move_acc += move_rate;
+                while (move_acc >= 0x0100u) {
+                    Cell next;
+                    unsigned char eat;
+                    move_acc -= 0x0100u;
+                    PROF_BEGIN(PROF_COL_MOVE);
+
+                    // Apply the next queued turn, then compute the next head cell with wrap-around
+#ifdef REPLAY_PLAY
+                    replay_move(&dir);
+#else
+#ifdef AUTOPILOT
+                    autopilot_move(&g_snake, &dir);
+#else
+                    input_next_turn(&dir);
+#endif
+#ifdef REPLAY_RECORD
+                    replay_move(&dir);
+#endif
+#endif
+                    next = snake_next_cell(&g_snake, dir);
+
+                    // Food slot + 1 on that cell (one marker lookup, any number of items)
+                    // Eating grows the snake, so the tail stays put for the collision test
+                    eat = food_at(next);
+
+                    // Collision check (O(1) against the occupancy grid)
+                    if (snake_will_self_collide_next(&g_snake, next, eat)) {
+                        // Self-collision: immediate game over
+                        // Set border to red
+                        HAL_BORDER = COL_RED;
+                        // wait for 1.5s on PAL (50 Hz) before showing game over
+                        wait_frames_blocking(75u);
+                        // Game over screen with final time
+                        render_game_over(game_clock(), 0u);
+                        return;
+                    }
+
+                    // Eat check
+                    if (eat) {
+                        // GROW on eat
+                        PROF_BEGIN(PROF_COL_FOOD);
+                        food_handle_eat_grow(&g_snake, dir, (unsigned char)(eat - 1u));
+
+                        // Board full: every cell is snake and no food is left, the game is won
+                        if (snake_free_count() == 0u && food_count() == 0u) {
+                            PROF_END();
+                            // Show the full board with a green border for 1.5s
+                            render_flush();
+                            HAL_BORDER = COL_GREEN;
+                            wait_frames_blocking(75u);
+                            render_game_over(game_clock(), 1u);
+                            return;
+                        }
+                    } else {
+                        // Normal step (no growth)
+                        Cell old_tail;
+                        snake_step(&g_snake, dir, &old_tail);
+
+                        // We already computed next before the step; that's the new head cell
+                        PROF_BEGIN(PROF_COL_RENDER);
+                        render_apply_step(old_tail, next);
+                    }
+                    PROF_END();
+
+                    // Turbo cap: drop any backlog beyond it, keep the fraction
+                    if (++moves == (unsigned char)MOVES_PER_FRAME_MAX) {
+                        move_acc &= 0x00FFu;
+                    }
+                }
+#ifdef RENDER_STATS
+                if (moves != 0u) move_stats(line0);
+#endif
+
+#ifdef SPRITE_HEAD
+                // Head sprite glides toward the next cell by the accumulator fraction
+                {
+                    unsigned char hx, hy;
+                    snake_head_xy(&g_snake, &hx, &hy);
+                    render_head_sprite(hx, hy, input_peek_turn(dir), (unsigned char)move_acc);
+                }
+#endif
+            }
+
+            /* Tick HUD + hunger once per second; end if starved.
+               This is pause-aware inside hud_tick(): it drains the edge and returns 0 while paused. */
+            PROF_BEGIN(PROF_COL_HUD);
+            unsigned char starved = hud_tick(&move_rate);
+            PROF_END();
+            if (starved) {
+                // wait for 1.5s on PAL (50 Hz) before showing game over
+                wait_frames_blocking(75u);
+                // Game over screen with final time
+                render_game_over(game_clock(), 0u);
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef GAME_H
+#define GAME_H
+
+// game.h
+// One game session (used by main.c's restart loop and by the host simulator)
+
+// Run one full game until collision or starvation.
+// Draws the Game Over screen with the final time before returning.
+void game_loop(void);
+
+#endif
@@ -0,0 +1,319 @@
+#ifndef HAL_H
+#define HAL_H
+
+// hal.h
+// Thin hardware abstraction for Snake.
+// Game modules reach the machine only through this header:
+// - screen and colour RAM bases
+// - VIC-II border, background, raster and sprite registers
+// - SID voice 3 random numbers
+// - CIA1 keyboard matrix and joystick port 2
+// - CIA2 cycle counter (for measurements)
+// - the raster IRQ of the -DFRAME_IRQ frame engine
+// The default build maps everything onto the real C64 registers (all inline,
+// no cost over direct access). Building with -DHAL_HOST maps the same names
+// onto an in-memory machine implemented in host/hal_host.c (see host/).
+// Building with -DVICE_CHECK keeps the real hardware but takes keyboard and
+// random numbers from the fixed session in check.c (see vice/).
+// Building with -DSCREEN_DOUBLE adds a second text screen for page flipping.
+
+#ifndef HAL_HOST
+
+/* ------------------------------------------------------------
+   C64 (KickC) implementation
+------------------------------------------------------------ */
+#include <c64.h>
+
+// Placement of hot state (see tools/layout.sh for the resulting map):
+// HAL_ZP puts a variable in zero page, HAL_ALIGN(n) starts it on an n-byte
+// boundary (0x100 = own page: indexed reads never cross a page)
+#define HAL_ZP          __zp
+#define HAL_ALIGN(n)    __align(n)
+
+// Unused parameter: KickC has no (void) casts, the bare expression touches it
+#define HAL_UNUSED(x)   x
+
+// Text screen and colour RAM base addresses
+#define HAL_COLOR_RAM   ((unsigned char*)0xD800)
+
+#ifndef SCREEN_DOUBLE
+#define HAL_SCREEN      ((unsigned char*)0x0400)
+
+// One 64-byte sprite image in the cassette buffer ($0340 = VIC block 13)
+#define HAL_SPRITE_DATA   ((unsigned char*)0x0340)
+#define HAL_SPRITE_BLOCK  13
+#else
+// Two screens in VIC bank 2 ($8000-$BFFF, above the program; the character
+// ROM shows at $9000): screen A at $8000, screen B at $8400
+#define HAL_SCREEN      ((unsigned char*)0x8000)
+#define HAL_SCREEN_B    ((unsigned char*)0x8400)
+
+// The sprite image moves into the same bank ($8800 = block 32)
+#define HAL_SPRITE_DATA   ((unsigned char*)0x8800)
+#define HAL_SPRITE_BLOCK  32
+#endif
+
+// Raw VIC-II registers (avoid <c64.h> field-name drift)
+#define HAL_VIC         ((volatile unsigned char*)0xD000)
+#define HAL_BORDER      (*((volatile unsigned char*)0xD020))
+#define HAL_BG          (*((volatile unsigned char*)0xD021))
+#define HAL_RASTER      (*((volatile unsigned char*)0xD012))
+#define HAL_CONTROL1    (*((volatile unsigned char*)0xD011))
+#define HAL_MEMPTR      (*((volatile unsigned char*)0xD018))
+#define HAL_IRQ_STATUS  (*((volatile unsigned char*)0xD019))
+#define HAL_IRQ_ENABLE  (*((volatile unsigned char*)0xD01A))
+
+// Raw CIA1 keyboard ports (PRA selects rows, PRB reads columns; active low)
+// PRA also reads joystick port 2
+#define HAL_CIA1_PRA    (*((volatile unsigned char*)0xDC00))
+#define HAL_CIA1_PRB    (*((volatile unsigned char*)0xDC01))
+#define HAL_CIA1_DDRA   (*((volatile unsigned char*)0xDC02))
+#define HAL_CIA1_DDRB   (*((volatile unsigned char*)0xDC03))
+#define HAL_CIA1_ICR    (*((volatile unsigned char*)0xDC0D))
+
+// Raw CIA2 timer registers (timer A counts cycles, timer B counts A underflows)
+#define HAL_CIA2_TA_LO  (*((volatile unsigned char*)0xDD04))
+#define HAL_CIA2_TA_HI  (*((volatile unsigned char*)0xDD05))
+#define HAL_CIA2_TB_LO  (*((volatile unsigned char*)0xDD06))
+#define HAL_CIA2_TB_HI  (*((volatile unsigned char*)0xDD07))
+#define HAL_CIA2_CRA    (*((volatile unsigned char*)0xDD0E))
+#define HAL_CIA2_CRB    (*((volatile unsigned char*)0xDD0F))
+
+// CIA2 port A bits 0-1 select the VIC-II bank (inverted: %01 = bank 2)
+#define HAL_CIA2_PRA    (*((volatile unsigned char*)0xDD00))
+
+#ifdef VICE_CHECK
+// Session-driven input and RNG (check.c)
+void check_frame(void);
+void hal_rnd_init(void);
+unsigned char hal_rnd(void);
+unsigned char hal_kbd_read(unsigned char rows);
+#endif
+
+// Wait until the raster leaves line 255 (once per PAL frame)
+static inline void hal_wait_raster_wrap(void) {
+    while (HAL_RASTER != 0xFF) ;
+    while (HAL_RASTER == 0xFF) ;
+#ifdef VICE_CHECK
+    check_frame();
+#endif
+}
+
+// Raster IRQ handler attribute: the handler exits through the KERNAL
+// register restore ($EA81), which ends with RTI.
+// Experimental: not yet verified with KickC 0.8.6 or in VICE (FRAME_IRQ only)
+#define HAL_IRQ  __interrupt(rom_min_c64)
+
+// Install 'irq' as the raster IRQ at 'line' (below 256) and silence the
+// CIA1 (KERNAL jiffy/keyboard) IRQ
+static inline void hal_frame_irq_install(void (*irq)(void), unsigned char line) {
+    asm { sei }
+    HAL_CIA1_ICR = 0x7F;
+    HAL_CIA1_ICR;
+    HAL_CONTROL1 &= 0x7F;
+    HAL_RASTER = line;
+    *KERNEL_IRQ = irq;
+    HAL_IRQ_ENABLE = 0x01;
+    HAL_IRQ_STATUS = 0x01;
+    asm { cli }
+}
+
+// Acknowledge the raster IRQ (first thing in the handler)
+static inline void hal_frame_irq_ack(void) {
+    HAL_IRQ_STATUS = 0x01;
+}
+
+// Body of a busy wait for the next IRQ frame: nothing, the IRQ ends it
+#define hal_frame_idle()
+
+// Current raster line 0..311 ($D011 bit 7 is raster bit 8)
+static inline unsigned int hal_raster_line(void) {
+    unsigned int line = HAL_RASTER;
+    if (HAL_CONTROL1 & 0x80) line += 256u;
+    return line;
+}
+
+// Restart the 32-bit cycle counter at 0 (CIA2 timer A -> timer B chain)
+static inline void hal_cycles_start(void) {
+    HAL_CIA2_CRA = 0x00;
+    HAL_CIA2_CRB = 0x00;
+    HAL_CIA2_TA_LO = 0xFF;
+    HAL_CIA2_TA_HI = 0xFF;
+    HAL_CIA2_TB_LO = 0xFF;
+    HAL_CIA2_TB_HI = 0xFF;
+    // Timer B: force load, count timer A underflows, start
+    HAL_CIA2_CRB = 0x51;
+    // Timer A: force load, count system cycles, start
+    HAL_CIA2_CRA = 0x11;
+}
+
+// Cycles since hal_cycles_start() (timers count down from $FFFFFFFF)
+// Timer A is paused while the four bytes are read, so the value is never torn;
+// the few cycles spent paused are not counted
+static inline unsigned long hal_cycles_read(void) {
+    HAL_CIA2_CRA = 0x00;
+    unsigned char al = HAL_CIA2_TA_LO;
+    unsigned char ah = HAL_CIA2_TA_HI;
+    unsigned char bl = HAL_CIA2_TB_LO;
+    unsigned char bh = HAL_CIA2_TB_HI;
+    HAL_CIA2_CRA = 0x01;
+    unsigned long t = MAKELONG4(bh, bl, ah, al);
+    return 0xFFFFFFFFul - t;
+}
+
+#ifdef SCREEN_DOUBLE
+// Show screen A (b = 0) or B (b = 1); character ROM at bank offset $1000.
+// Takes effect from the next frame when called in the border
+static inline void hal_screen_show(unsigned char b) {
+    HAL_CIA2_PRA = (unsigned char)((HAL_CIA2_PRA & 0xFC) | 0x01);
+    HAL_MEMPTR = b ? 0x14 : 0x04;
+}
+#endif
+
+// CIA1 port directions for scanning: rows (port A) out, columns (port B) in
+static inline void hal_input_init(void) {
+    HAL_CIA1_DDRA = 0xFF;
+    HAL_CIA1_DDRB = 0x00;
+}
+
+// Joystick port 2 (active low: bit 0 up, 1 down, 2 left, 3 right, 4 fire)
+// No keyboard row is selected while reading, so keys do not show up here
+static inline unsigned char hal_joy2_read(void) {
+    unsigned char save = HAL_CIA1_PRA;
+    HAL_CIA1_PRA = 0xFF;
+    unsigned char joy = HAL_CIA1_PRA;
+    HAL_CIA1_PRA = save;
+    return joy;
+}
+
+#ifndef VICE_CHECK
+
+// One-time init of the SID voice 3 noise generator
+static inline void hal_rnd_init(void) { sid_rnd_init(); }
+
+// Random byte from SID voice 3
+static inline unsigned char hal_rnd(void) { return (unsigned char)sid_rnd(); }
+
+// Select keyboard rows (active-low mask) and return the column bits (active low)
+static inline unsigned char hal_kbd_read(unsigned char rows) {
+    unsigned char save = HAL_CIA1_PRA;
+    HAL_CIA1_PRA = rows;
+    unsigned char cols = HAL_CIA1_PRB;
+    HAL_CIA1_PRA = save;
+    return cols;
+}
+
+#endif
+
+// Host builds can stop the game loop; on the C64 it runs forever
+#define hal_quit_requested()  0
+
+#else
+
+/* ------------------------------------------------------------
+   Host (gcc/clang) implementation: see host/hal_host.c
+------------------------------------------------------------ */
+
+// Placement directives have no meaning on the host
+#define HAL_ZP
+#define HAL_ALIGN(n)
+
+// Unused parameter: a (void) cast keeps -Wextra quiet
+#define HAL_UNUSED(x)   (void)(x)
+
+// In-memory text screen (40x25 + sprite pointers at $3F8) and colour RAM
+extern unsigned char hal_screen[1024];
+extern unsigned char hal_color[1000];
+#define HAL_SCREEN      (hal_screen)
+#define HAL_COLOR_RAM   (hal_color)
+
+// Second screen (-DSCREEN_DOUBLE); hal_screen_show() picks the one shown
+extern unsigned char hal_screen_b[1024];
+#define HAL_SCREEN_B    (hal_screen_b)
+void hal_screen_show(unsigned char b);
+
+// Sprite image memory (one 64-byte block)
+extern unsigned char hal_sprite_data[64];
+#define HAL_SPRITE_DATA   (hal_sprite_data)
+#define HAL_SPRITE_BLOCK  13
+
+// VIC-II register file (sprite registers are read back by tests/dumps)
+extern volatile unsigned char hal_vic[0x30];
+#define HAL_VIC         (hal_vic)
+
+// Border and background colour latches
+extern volatile unsigned char hal_border;
+extern volatile unsigned char hal_bg;
+#define HAL_BORDER      (hal_border)
+#define HAL_BG          (hal_bg)
+
+// Seedable LFSR in place of SID voice 3
+void hal_rnd_init(void);
+unsigned char hal_rnd(void);
+
+// Ends one simulated frame: advances the scripted input source, then runs
+// the installed frame IRQ handler (if any)
+void hal_wait_raster_wrap(void);
+
+// Frame IRQ: the handler is a plain function, called once per simulated frame
+#define HAL_IRQ
+void hal_frame_irq_install(void (*irq)(void), unsigned char line);
+#define hal_frame_irq_ack()
+
+// A busy wait for the next IRQ frame ends one simulated frame
+void hal_frame_idle(void);
+
+// Simulated raster line (always 0: flushes cost no raster time)
+unsigned int hal_raster_line(void);
+
+// Nanosecond clock in place of the CIA2 cycle counter
+void hal_cycles_start(void);
+unsigned long hal_cycles_read(void);
+
+// Keyboard matrix read against the scripted key state
+void hal_input_init(void);
+unsigned char hal_kbd_read(unsigned char rows);
+
+// Joystick port 2 against the scripted stick state (active low)
+unsigned char hal_joy2_read(void);
+
+// 1 once the host driver's frame budget is used up
+unsigned char hal_quit_requested(void);
+
+#endif
+
+// Extended background colour mode (both builds index HAL_VIC): $D011 bit 6
+// set, the top two bits of a screen code pick the cell background from
+// $D021 (HAL_BG) or background colours 1-3; only glyphs 0-63 are drawn
+#define HAL_VIC_CTRL1   (HAL_VIC[0x11])
+#define HAL_ECM_BIT     0x40
+#define HAL_BG1         (HAL_VIC[0x22])
+#define HAL_BG2         (HAL_VIC[0x23])
+#define HAL_BG3         (HAL_VIC[0x24])
+
+// Sprite registers (both builds index HAL_VIC)
+#define HAL_SPR0_X      (HAL_VIC[0x00])
+#define HAL_SPR0_Y      (HAL_VIC[0x01])
+#define HAL_SPR_XMSB    (HAL_VIC[0x10])
+#define HAL_SPR_ENABLE  (HAL_VIC[0x15])
+#define HAL_SPR0_COL    (HAL_VIC[0x27])
+
+// Sprite pointers follow the 1000 screen codes
+#define HAL_SPR_PTRS    (HAL_SCREEN + 0x3F8)
+#define HAL_SPR_PTRS_B  (HAL_SCREEN_B + 0x3F8)
+
+#if defined(HAL_HOST) || defined(VICE_CHECK)
+
+// Matrix positions of the game keys for scripted input: (row << 3) | column
+// (same codes as <c64-keyboard.h>)
+#define KEY_W      0x09
+#define KEY_A      0x0a
+#define KEY_S      0x0d
+#define KEY_R      0x11
+#define KEY_D      0x12
+#define KEY_P      0x29
+#define KEY_SPACE  0x3c
+
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+// hal_host.c
+// In-memory C64 for host builds of Snake (-DHAL_HOST):
+// - 40x25 screen and colour RAM arrays (two screens for -DSCREEN_DOUBLE)
+// - VIC-II register file, border/background latches
+// - 32-bit xorshift RNG in place of SID voice 3
+// - monotonic nanosecond clock in place of the CIA2 cycle counter
+// - 8x8 keyboard matrix and joystick port 2 driven by a per-frame input callback
+// - frame counter with an optional budget (ends the game loop)
+// - frame IRQ (-DFRAME_IRQ): the handler runs at the end of every frame
+
+#include <string.h>
+#include <time.h>
+#include "hal.h"
+#include "hal_host.h"
+
+unsigned char hal_screen[1024];
+unsigned char hal_screen_b[1024];
+unsigned char hal_color[1000];
+unsigned char hal_sprite_data[64];
+volatile unsigned char hal_vic[0x30];
+volatile unsigned char hal_border;
+volatile unsigned char hal_bg;
+
+unsigned char hal_host_keys[8];
+unsigned char hal_host_joy;
+void (*hal_host_input)(unsigned long frame);
+
+static uint32_t g_rng = 1u;
+static void (*g_frame_irq)(void);
+static unsigned long g_frames;
+static unsigned long g_budget;
+
+void hal_host_reset(uint32_t seed, unsigned long frame_budget) {
+    memset(hal_screen, 0x20, sizeof(hal_screen));
+    memset(hal_screen_b, 0x20, sizeof(hal_screen_b));
+    memset(hal_color, 0, sizeof(hal_color));
+    memset(hal_host_keys, 0, sizeof(hal_host_keys));
+    hal_host_joy = 0;
+    memset((void*)hal_vic, 0, sizeof(hal_vic));
+    hal_border = 0;
+    hal_bg = 0;
+    g_rng = seed ? seed : 1u;
+    g_frames = 0;
+    g_budget = frame_budget;
+    g_frame_irq = NULL;
+}
+
+unsigned long hal_host_frames(void) { return g_frames; }
+
+const unsigned char* hal_host_screen(void) {
+    return (hal_vic[0x18] & 0xF0u) == 0x10u ? hal_screen_b : hal_screen;
+}
+
+void hal_host_key(unsigned char key, unsigned char down) {
+    unsigned char row = (unsigned char)(key >> 3);
+    unsigned char bit = (unsigned char)(1u << (key & 7));
+    if (down) hal_host_keys[row] |= bit;
+    else      hal_host_keys[row] &= (unsigned char)~bit;
+}
+
+/* ------------------------------------------------------------
+   hal.h host implementation
+------------------------------------------------------------ */
+
+void hal_rnd_init(void) {
+}
+
+// $D018 as on the C64: screen B at bank offset $0400, A at $0000
+void hal_screen_show(unsigned char b) {
+    hal_vic[0x18] = b ? 0x14 : 0x04;
+}
+
+unsigned char hal_rnd(void) {
+    uint32_t x = g_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_rng = x;
+    return (unsigned char)(x >> 24);
+}
+
+void hal_wait_raster_wrap(void) {
+    if (hal_host_input) hal_host_input(g_frames);
+    g_frames++;
+    if (g_frame_irq) g_frame_irq();
+}
+
+// The raster line has no meaning here: the handler runs at every frame end
+void hal_frame_irq_install(void (*irq)(void), unsigned char line) {
+    g_frame_irq = irq;
+    (void)line;
+}
+
+void hal_frame_idle(void) {
+    hal_wait_raster_wrap();
+}
+
+unsigned int hal_raster_line(void) {
+    return 0u;
+}
+
+static struct timespec g_cycles_t0;
+
+void hal_cycles_start(void) {
+    clock_gettime(CLOCK_MONOTONIC, &g_cycles_t0);
+}
+
+unsigned long hal_cycles_read(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (unsigned long)(t.tv_sec - g_cycles_t0.tv_sec) * 1000000000ul
+         + (unsigned long)t.tv_nsec - (unsigned long)g_cycles_t0.tv_nsec;
+}
+
+void hal_input_init(void) {
+}
+
+unsigned char hal_kbd_read(unsigned char rows) {
+    unsigned char cols = 0;
+    for (unsigned char r = 0; r < 8; ++r) {
+        if ((rows & (1u << r)) == 0) cols |= hal_host_keys[r];
+    }
+    return (unsigned char)~cols;
+}
+
+unsigned char hal_joy2_read(void) {
+    return (unsigned char)~hal_host_joy;
+}
+
+unsigned char hal_quit_requested(void) {
+    if (g_budget == 0) return 0u;
+    return (unsigned char)(g_frames >= g_budget);
+}
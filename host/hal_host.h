@@ -0,0 +1,34 @@
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+// hal_host.h
+// Host-side controls for the in-memory machine behind hal.h (-DHAL_HOST).
+// Used by the simulator driver only; game modules never include this.
+
+#include <stdint.h>
+
+// Keyboard matrix state for the current frame: bit c of row r set = key down
+extern unsigned char hal_host_keys[8];
+
+// Joystick port 2 state for the current frame (active high: bit 0 up,
+// 1 down, 2 left, 3 right, 4 fire)
+extern unsigned char hal_host_joy;
+
+// Called once per simulated frame (from hal_wait_raster_wrap) to update
+// hal_host_keys; frame counts from 0. NULL leaves the keys unchanged.
+extern void (*hal_host_input)(unsigned long frame);
+
+// Reset the simulated machine: clears screen/colour RAM, keys and joystick,
+// seeds the RNG and sets the frame budget (0 = unlimited)
+void hal_host_reset(uint32_t seed, unsigned long frame_budget);
+
+// Frames simulated since the last reset
+unsigned long hal_host_frames(void);
+
+// The screen the VIC-II shows ($D018 picks screen B with -DSCREEN_DOUBLE)
+const unsigned char* hal_host_screen(void);
+
+// Press or release a key by its KEY_* code for the coming frames
+void hal_host_key(unsigned char key, unsigned char down);
+
+#endif
@@ -0,0 +1,287 @@
+// sim.c
+// Host simulator for Snake (gcc/clang, -DHAL_HOST).
+// Runs the unmodified game modules against the in-memory machine in hal_host.c.
+//
+//   sim game  [-f frames] [-s seed] [-i script] [-d]
+//       Full game_loop() sessions (restarting after each game over) for a fixed
+//       number of frames. Input comes from a script or a seeded random steerer.
+//       Prints frames, games and an FNV-1a hash of screen + colour RAM; -d also
+//       dumps the final screen as text. Same seed + script => same hash.
+//       -l: with DEFS=-DREPLAY_RECORD, save the last game's replay log there;
+//       with DEFS=-DREPLAY_PLAY, load it and replay it instead of the keys.
+//
+//   sim bench [-m moves] [-s seed]
+//       Tight move loop over snake.c / food.c / render.c (step, grow, collision,
+//       spawn, queue flush) without frame pacing; prints moves per second.
+//
+// Script format: one "<frame> <keys>" per line, keys held from that frame on.
+// Keys: W A S D P R, '_' for SPACE, '-' for none; joystick port 2 as 8 2 4 6
+// (up down left right) and 0 (fire). Lines starting with '#' are ignored.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hal.h"
+#include "hal_host.h"
+#include "game.h"
+#include "snake.h"
+#include "food.h"
+#include "render.h"
+#include "replay.h"
+#include "sys.h"
+
+/* ------------------------------------------------------------
+   Scripted input
+------------------------------------------------------------ */
+#define SCRIPT_MAX 65536
+
+static unsigned long g_script_frame[SCRIPT_MAX];
+static char          g_script_keys[SCRIPT_MAX][8];
+static unsigned long g_script_n;
+static unsigned long g_script_pos;
+static uint32_t      g_steer_rng;
+
+static void set_keys(const char* keys) {
+    memset(hal_host_keys, 0, sizeof(hal_host_keys));
+    hal_host_joy = 0;
+    for (const char* k = keys; *k; ++k) {
+        switch (*k) {
+        case 'W': hal_host_key(KEY_W, 1); break;
+        case 'A': hal_host_key(KEY_A, 1); break;
+        case 'S': hal_host_key(KEY_S, 1); break;
+        case 'D': hal_host_key(KEY_D, 1); break;
+        case 'P': hal_host_key(KEY_P, 1); break;
+        case 'R': hal_host_key(KEY_R, 1); break;
+        case '_': hal_host_key(KEY_SPACE, 1); break;
+        case '8': hal_host_joy |= 0x01; break;
+        case '2': hal_host_joy |= 0x02; break;
+        case '4': hal_host_joy |= 0x04; break;
+        case '6': hal_host_joy |= 0x08; break;
+        case '0': hal_host_joy |= 0x10; break;
+        default: break;
+        }
+    }
+}
+
+static void script_input(unsigned long frame) {
+    while (g_script_pos < g_script_n && g_script_frame[g_script_pos] <= frame) {
+        set_keys(g_script_keys[g_script_pos]);
+        g_script_pos++;
+    }
+}
+
+// No script: tap a random direction every 6 frames
+static void random_input(unsigned long frame) {
+    static const char* const dirs[4] = { "W", "A", "S", "D" };
+    if (frame % 6u != 0u) {
+        set_keys("");
+        return;
+    }
+    g_steer_rng = g_steer_rng * 1103515245u + 12345u;
+    set_keys(dirs[(g_steer_rng >> 16) & 3u]);
+}
+
+static int load_script(const char* path) {
+    FILE* f = fopen(path, "r");
+    char line[128];
+    if (!f) {
+        perror(path);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), f) && g_script_n < SCRIPT_MAX) {
+        unsigned long fr;
+        char keys[8] = "";
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%lu %7s", &fr, keys) < 1) continue;
+        if (keys[0] == '-') keys[0] = 0;
+        g_script_frame[g_script_n] = fr;
+        strcpy(g_script_keys[g_script_n], keys);
+        g_script_n++;
+    }
+    fclose(f);
+    return 1;
+}
+
+/* ------------------------------------------------------------
+   Screen hash / dump
+------------------------------------------------------------ */
+static uint32_t screen_hash(void) {
+    const unsigned char* scr = hal_host_screen();
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < 1000; ++i) { h ^= scr[i]; h *= 16777619u; }
+    for (int i = 0; i < 1000; ++i) { h ^= (uint32_t)(hal_color[i] & 15u); h *= 16777619u; }
+    return h;
+}
+
+static char screen_to_ascii(unsigned char sc) {
+    if (sc >= 1 && sc <= 26) return (char)('A' + sc - 1);
+    if (sc >= 0x20 && sc <= 0x3f) return (char)sc;
+    if (sc == CH_SNAKE) return '#';
+    if (sc == CH_FOOD) return 'o';
+    return '?';
+}
+
+static void screen_dump(void) {
+    const unsigned char* scr = hal_host_screen();
+    for (int y = 0; y < MAP_H; ++y) {
+        char row[MAP_W + 1];
+        for (int x = 0; x < MAP_W; ++x) row[x] = screen_to_ascii(scr[y * MAP_W + x]);
+        row[MAP_W] = 0;
+        printf("|%s|\n", row);
+    }
+}
+
+/* ------------------------------------------------------------
+   Replay log file (REPLAY_RECORD writes it, REPLAY_PLAY reads it)
+------------------------------------------------------------ */
+static int replay_file(const char* path, int write) {
+#ifdef REPLAY
+    FILE* f = fopen(path, write ? "wb" : "rb");
+    size_t n;
+    if (!f) {
+        perror(path);
+        return 0;
+    }
+    if (write) n = fwrite(replay_buf, 1, sizeof(replay_buf), f);
+    else       n = fread(replay_buf, 1, sizeof(replay_buf), f);
+    fclose(f);
+    return n > REPLAY_HDR;
+#else
+    (void)write;
+    fprintf(stderr, "%s: build with DEFS=-DREPLAY_RECORD or -DREPLAY_PLAY\n", path);
+    return 0;
+#endif
+}
+
+/* ------------------------------------------------------------
+   Modes
+------------------------------------------------------------ */
+
+static int run_game(unsigned long frames, uint32_t seed, const char* script, int dump,
+                    const char* log) {
+    unsigned long games = 0;
+
+    hal_host_reset(seed, frames);
+    // Frame engine, as main() does (installs the frame IRQ with -DFRAME_IRQ)
+    sys_init();
+#ifdef REPLAY_PLAY
+    if (log && !replay_file(log, 0)) return 1;
+#endif
+    g_steer_rng = seed;
+    if (script) {
+        if (!load_script(script)) return 1;
+        hal_host_input = script_input;
+    } else {
+        hal_host_input = random_input;
+    }
+
+    while (!hal_quit_requested()) {
+        game_loop();
+        games++;
+    }
+
+    printf("frames %lu games %lu hash %08lx\n",
+           hal_host_frames(), games, (unsigned long)screen_hash());
+    if (dump) screen_dump();
+#ifndef REPLAY_PLAY
+    if (log && !replay_file(log, 1)) return 1;
+#endif
+    return 0;
+}
+
+static int run_bench(unsigned long moves, uint32_t seed) {
+    Snake s;
+    Direction dir = DIR_RIGHT;
+    unsigned long restarts = 0, eaten = 0;
+    unsigned int max_len = 0;
+    uint32_t steer = seed;
+    struct timespec t0, t1;
+
+    hal_host_reset(seed, 0);
+    hal_host_input = NULL;
+    snake_init(&s);
+    render_clear();
+    food_init();
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (unsigned long m = 0; m < moves; ++m) {
+        Cell next;
+        unsigned char eat, tries;
+
+        // Occasionally turn; then take the first direction that does not collide
+        steer = steer * 1103515245u + 12345u;
+        if (((steer >> 16) & 7u) == 0u) dir = (Direction)((steer >> 20) & 3u);
+        for (tries = 0; tries < 4; ++tries) {
+            next = snake_next_cell(&s, dir);
+            eat = food_at(next);
+            if (!snake_will_self_collide_next(&s, next, eat)) break;
+            dir = (Direction)((dir + 1) & 3);
+        }
+
+        if (tries == 4) {
+            // Boxed in: start over
+            restarts++;
+            snake_init(&s);
+            render_clear();
+            food_init();
+            continue;
+        }
+
+        if (eat) {
+            food_handle_eat_grow(&s, dir, (unsigned char)(eat - 1u));
+            eaten++;
+        } else {
+            Cell tail;
+            snake_step(&s, dir, &tail);
+            render_apply_step(tail, next);
+        }
+        render_flush();
+        if (s.len > max_len) max_len = s.len;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double secs = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("moves %lu eaten %lu restarts %lu max_len %u time %.3fs rate %.0f moves/s hash %08lx\n",
+           moves, eaten, restarts, (unsigned)max_len, secs,
+           secs > 0.0 ? (double)moves / secs : 0.0, (unsigned long)screen_hash());
+    return 0;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: sim game  [-f frames] [-s seed] [-i script] [-d] [-l replay.bin]\n"
+            "       sim bench [-m moves] [-s seed]\n");
+}
+
+int main(int argc, char** argv) {
+    unsigned long frames = 50ul * 60ul * 10ul;
+    unsigned long moves = 10000000ul;
+    uint32_t seed = 1u;
+    const char* script = NULL;
+    const char* log = NULL;
+    int dump = 0;
+
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    for (int i = 2; i < argc; ++i) {
+        if (!strcmp(argv[i], "-f") && i + 1 < argc)      frames = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) moves = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc) script = argv[++i];
+        else if (!strcmp(argv[i], "-l") && i + 1 < argc) log = argv[++i];
+        else if (!strcmp(argv[i], "-d"))                 dump = 1;
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    if (!strcmp(argv[1], "game"))  return run_game(frames, seed, script, dump, log);
+    if (!strcmp(argv[1], "bench")) return run_bench(moves, seed);
+    usage();
+    return 2;
+}
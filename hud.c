@@ -1,15 +1,18 @@
+#include "hud.h"
 #include "render.h"
 #include "timer.h"
 #include "pause.h"
 #include "hunger.h"
+#include "food.h"
+#include "autopilot.h"
 
 // Ticks once per second (on timer_second_edge()).
 // - Draws elapsed game time (pause-adjusted)
-// - Speeds up every 10 seconds down to a limit
+// - Ramps the movement rate smoothly up to its limit
+// - Ages bonus food
 // - Ticks hunger (and flashes border)
 // Returns 1 if hunger reached zero (starved), else 0.
-unsigned char hud_tick(unsigned char* move_interval,
-                       unsigned char* sec_since_speedup) {
+unsigned char hud_tick(unsigned int* move_rate) {
     // If paused, drain the edge and do nothing this frame
     if (pause_is_paused()) {
         pause_drain_second_edge();
@@ -17,18 +20,24 @@ unsigned char hud_tick(unsigned char* move_interval,
     }
 
     if (timer_second_edge()) {
-        // Time HUD (pause-adjusted)
-        render_draw_time(game_seconds());
-
-        // Speed ramp (every 10 seconds, to a floor of 2)
-        (*sec_since_speedup)++;
-        if ((unsigned char)(*sec_since_speedup) >= (unsigned char)10) {
-            if ((unsigned char)(*move_interval) > (unsigned char)2) {
-                (*move_interval)--;
-            }
-            *sec_since_speedup = 0u;
+        // Time HUD (pause-adjusted): BCD tick, only changed digits are redrawn
+        game_clock_tick();
+        render_draw_clock(game_clock());
+
+        // Speed ramp (a small step every second, up to the limit)
+        if (*move_rate < MOVE_RATE_MAX) {
+            *move_rate += MOVE_RATE_STEP;
+            if (*move_rate > MOVE_RATE_MAX) *move_rate = MOVE_RATE_MAX;
         }
 
+#ifdef RENDER_STATS
+        // Render queue flush cost (raster lines) and depth
+        render_draw_flush_stats();
+#endif
+
+        // Bonus food lifetimes
+        food_tick();
+
         // Hunger countdown + border flash
         if (hunger_tick_and_flash()) {
             return 1u;  // starved -> game over
@@ -40,10 +49,19 @@ unsigned char hud_tick(unsigned char* move_interval,
 static unsigned char g_timer_x = 0u;
 static unsigned char g_timer_y = 0u;
 
-// returns 1 if (x,y) is inside "MM:SS" (5 chars wide on one row)
+// returns 1 if (x,y) is inside the clock: "MM:SS", widening to "MMMM:SS"
+// (7 chars on one row) from 100 minutes on
 unsigned char hud_covers_cell(unsigned char x, unsigned char y) {
     if (y == g_timer_y) {
-        if (x >= g_timer_x && x <= (unsigned char)(g_timer_x + 4u)) return 1u;
+        if (x >= g_timer_x && x <= (unsigned char)(g_timer_x + 6u)) return 1u;
+#ifdef RENDER_STATS
+        // "Mnn Fnn Qnn" move/flush stats at the right end of the row
+        if (x >= (unsigned char)29) return 1u;
+#endif
+#ifdef AUTOPILOT
+        // "Annnnn" autopilot decision cycles
+        if (x >= (unsigned char)AUTOPILOT_HUD_X && x <= (unsigned char)(AUTOPILOT_HUD_X + 5u)) return 1u;
+#endif
     }
     return 0u;
 }
\ No newline at end of file
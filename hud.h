@@ -1,13 +1,35 @@
 #ifndef HUD_H
 #define HUD_H
 
+// Movement rate: moves per frame in 8.8 fixed point (0x0100 = one move every
+// frame, 0x0020 = one every 8 frames). game_loop() adds it to an accumulator
+// each frame and makes one move per whole unit.
+// Start: 1 move / 8 frames (6.25 moves/s on PAL)
+#ifndef MOVE_RATE_START
+#define MOVE_RATE_START  0x0020u
+#endif
+
+// Added once per second (2/256 move per frame, about 0.4 moves/s)
+#ifndef MOVE_RATE_STEP
+#define MOVE_RATE_STEP   0x0002u
+#endif
+
+// Top speed: 1 move / 2 frames (25 moves/s); -DMOVE_TURBO keeps ramping up to
+// 2 moves every frame (100 moves/s)
+#ifndef MOVE_RATE_MAX
+#ifdef MOVE_TURBO
+#define MOVE_RATE_MAX    0x0200u
+#else
+#define MOVE_RATE_MAX    0x0080u
+#endif
+#endif
+
 // Ticks once per second (on timer_second_edge()).
 // - Draws elapsed game time (pause-adjusted)
-// - Speeds up every 10 seconds down to a limit
+// - Raises *move_rate by MOVE_RATE_STEP up to MOVE_RATE_MAX
 // - Ticks hunger (and flashes border)
 // Returns 1 if hunger reached zero (starved), else 0.
-unsigned char hud_tick(unsigned char* move_interval,
-                       unsigned char* sec_since_speedup);
+unsigned char hud_tick(unsigned int* move_rate);
 
 // Return 1 if (x,y) is reserved for HUD (e.g., timer area), else 0
 unsigned char hud_covers_cell(unsigned char x, unsigned char y);
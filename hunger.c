@@ -1,6 +1,14 @@
-#include <c64.h>
+#include "hal.h"
 #include "hunger.h"
 
+// Border writes for the hunger flash. With -DPROFILE_RASTER the border shows
+// raster bars instead, so the flash is paused (hunger itself still counts down).
+#ifdef PROFILE_RASTER
+#define HUNGER_BORDER(col)
+#else
+#define HUNGER_BORDER(col)  HAL_BORDER = (col)
+#endif
+
 // Internal hunger state
 static unsigned char hunger_remaining    = HUNGER_LIMIT_SEC;
 // Used to toggle border color in warning state
@@ -10,14 +18,14 @@ static unsigned char hunger_flash_toggle = 0u;
 void hunger_init(void) {
     hunger_remaining    = HUNGER_LIMIT_SEC;
     hunger_flash_toggle = 0u;
-    VICII->BORDER_COLOR = COL_LIGHT_BLUE;
+    HUNGER_BORDER(COL_LIGHT_BLUE);
 }
 
 // Restore hunger to full and set calm border (called on food eat)
 void hunger_reset_on_feed(void) {
     hunger_remaining    = HUNGER_LIMIT_SEC;
     hunger_flash_toggle = 0u;
-    VICII->BORDER_COLOR = COL_LIGHT_BLUE;
+    HUNGER_BORDER(COL_LIGHT_BLUE);
 }
 
 // Call exactly once per timer_second_edge()
@@ -35,16 +43,20 @@ unsigned char hunger_tick_and_flash(void) {
         // Flash if in warning state
         if ((unsigned char)(hr - 1u) < warn) {
             hunger_flash_toggle = (unsigned char)(1u - hunger_flash_toggle);
-            VICII->BORDER_COLOR = (hunger_flash_toggle ? COL_PINK : COL_RED);
+            HUNGER_BORDER(hunger_flash_toggle ? COL_PINK : COL_RED);
         } else {
-            VICII->BORDER_COLOR = COL_LIGHT_BLUE;
+            HUNGER_BORDER(COL_LIGHT_BLUE);
         }
     }
 
     // Starvation check
     if (hunger_remaining == 0u) {
-        VICII->BORDER_COLOR = COL_RED;
+        HUNGER_BORDER(COL_RED);
+        // Autopilot soak runs (-DAUTOPILOT) play every game to a full board:
+        // the countdown and the flash still run, but starving does not end it
+#ifndef AUTOPILOT
         return 1u;
+#endif
     }
 
     // Not yet starved
@@ -57,14 +69,14 @@ void hunger_apply_border_now(void) {
     unsigned char hr = hunger_remaining;
 
     if (hr == 0u) {
-        VICII->BORDER_COLOR = COL_RED;
+        HUNGER_BORDER(COL_RED);
         return;
     }
 
     // Flash if in warning state
     if ((unsigned char)(hr - 1u) < warn) {
-        VICII->BORDER_COLOR = (hunger_flash_toggle ? COL_PINK : COL_RED);
+        HUNGER_BORDER(hunger_flash_toggle ? COL_PINK : COL_RED);
     } else {
-        VICII->BORDER_COLOR = COL_LIGHT_BLUE;
+        HUNGER_BORDER(COL_LIGHT_BLUE);
     }
 }
@@ -9,6 +9,7 @@
 
 // Colors (values per <c64.h>)
 #define COL_RED           2u
+#define COL_GREEN         5u
 #define COL_PINK         10u
 #define COL_LIGHT_BLUE   14u
 
@@ -1,128 +1,162 @@
 // input.c
-// Keyboard input handler for Snake (WASD control on C64)
+// Keyboard + joystick input handler for Snake (WASD control on C64)
+// One scan per frame reads only the four matrix rows that hold our keys
+// plus joystick port 2, so input costs five CIA1 reads per frame
 
-#include <c64.h>
-#include <c64-keyboard.h>
+#include "hal.h"
 #include "input.h"
-
-// Store the last accepted direction to prevent 180° reversal
-static Direction last_dir;
-
-// Initialize the keyboard system and input state
+#include "replay.h"
+
+// Keyboard matrix rows (select mask for CIA1 port A, active low)
+#define ROW1  ((unsigned char)(255u ^ (1u << 1)))   // W A S
+#define ROW2  ((unsigned char)(255u ^ (1u << 2)))   // D R
+#define ROW5  ((unsigned char)(255u ^ (1u << 5)))   // P
+#define ROW7  ((unsigned char)(255u ^ (1u << 7)))   // SPACE
+
+// Column bits within those rows (CIA1 port B, active low)
+#define COL_W      (1u << 1)
+#define COL_A      (1u << 2)
+#define COL_S      (1u << 5)
+#define COL_D      (1u << 2)
+#define COL_R      (1u << 1)
+#define COL_P      (1u << 1)
+#define COL_SPACE  (1u << 4)
+
+// Joystick port 2 bits (CIA1 port A, active low)
+#define JOY_UP     (1u << 0)
+#define JOY_DOWN   (1u << 1)
+#define JOY_LEFT   (1u << 2)
+#define JOY_RIGHT  (1u << 3)
+#define JOY_FIRE   (1u << 4)
+
+// Turn queue: ring of pending directions, oldest at g_turn_head
+static Direction g_turns[TURNQ_SIZE];
+static unsigned char g_turn_head = 0u;
+static unsigned char g_turn_n = 0u;
+
+// Keys held at the latest scan, and keys that went down at it
+static HAL_ZP unsigned char g_held = 0u;
+static HAL_ZP unsigned char g_pressed = 0u;
+
+// Initialize the input state for a new game
 void input_init(void) {
-    // Initialize C64 keyboard driver
-    keyboard_init();
+    // CIA1 data directions (port A rows out, port B columns in)
+    hal_input_init();
 
-    // Default direction (snake starts moving right)
-    last_dir = DIR_RIGHT;
+    // No turns pending
+    g_turn_head = 0u;
+    g_turn_n = 0u;
 
     // Light blue border for visual confirmation
-    VICII->BORDER_COLOR = 14;
+    HAL_BORDER = 14;
 }
 
-// Update player input once per frame
-// Reads keyboard state, updates direction, prevents instant reversal
-void input_update(Direction* dir) {
-    // Scan keyboard events for new keypresses
-    keyboard_event_scan();
-
-    // Start with the currently active direction
-    Direction want = *dir;
-
-    // Handle WASD steering controls
-    if (keyboard_key_pressed(KEY_W))      want = DIR_UP;
-    else if (keyboard_key_pressed(KEY_S)) want = DIR_DOWN;
-    else if (keyboard_key_pressed(KEY_A)) want = DIR_LEFT;
-    else if (keyboard_key_pressed(KEY_D)) want = DIR_RIGHT;
-
-    // Prevent reversing direction directly (180° turn)
-    if (!((last_dir == DIR_UP    && want == DIR_DOWN) ||
-          (last_dir == DIR_DOWN  && want == DIR_UP)   ||
-          (last_dir == DIR_LEFT  && want == DIR_RIGHT)||
-          (last_dir == DIR_RIGHT && want == DIR_LEFT))) {
-
-        // Accept new direction and update history
-        *dir = want;
-        last_dir = want;
-    }
-}
+// One pass over the needed rows and the joystick
+void input_scan(void) {
+    unsigned char held = 0u;
 
-// Reads the current hardware state of the SPACE key directly from the
-// Returns 1 if SPACE is physically held down, else 0.
-static unsigned char raw_space_down(void) {
-    volatile unsigned char* const CIA1_PRA = (unsigned char*)0xDC00;
-    volatile unsigned char* const CIA1_PRB = (unsigned char*)0xDC01;
+    // Matrix reads are active low: a clear column bit is a held key
+    unsigned char c = hal_kbd_read(ROW1);
+    if ((c & COL_W) == 0u) held |= IN_UP;
+    if ((c & COL_A) == 0u) held |= IN_LEFT;
+    if ((c & COL_S) == 0u) held |= IN_DOWN;
 
-    unsigned char save = *CIA1_PRA;
-    unsigned char down = 0u;
+    c = hal_kbd_read(ROW2);
+    if ((c & COL_D) == 0u) held |= IN_RIGHT;
+    if ((c & COL_R) == 0u) held |= IN_RESTART;
 
-    // 'SPACE': Row 7, Col 4
-    *CIA1_PRA = (unsigned char)(255u ^ (1u << 7));
-    // col 4 is also used by 'D', but that's fine for our purposes
-    if ( ((*CIA1_PRB) & (1u << 4)) == 0u ) down = 1u;
+    c = hal_kbd_read(ROW5);
+    if ((c & COL_P) == 0u) held |= IN_PAUSE;
 
-    *CIA1_PRA = save;
-    return down;
-}
+    c = hal_kbd_read(ROW7);
+    if ((c & COL_SPACE) == 0u) held |= IN_FIRE;
 
-// Reads the current hardware state of the 'P' key directly from the
-// Returns 1 if the 'P' key is physically held down, else 0.
-static unsigned char raw_p_down(void) {
-    volatile unsigned char* const CIA1_PRA = (unsigned char*)0xDC00;
-    volatile unsigned char* const CIA1_PRB = (unsigned char*)0xDC01;
+    // Joystick port 2: the stick bits line up with IN_UP..IN_RIGHT, fire with IN_FIRE
+    held |= (unsigned char)((hal_joy2_read() ^ 0xFFu) & (JOY_UP | JOY_DOWN | JOY_LEFT | JOY_RIGHT | JOY_FIRE));
 
-    unsigned char save = *CIA1_PRA;
-    unsigned char down = 0u;
+    // Edges: down now, up at the previous scan
+    g_pressed = held & (g_held ^ 0xFFu);
+    g_held = held;
+}
 
-    // 'P': Row 1, Col 2
-    *CIA1_PRA = (unsigned char)(255u ^ (1u << 1));
-    // col 2 is also used by 'S', but that's fine for our purposes
-    if ( ((*CIA1_PRB) & (1u << 2)) == 0u ) down = 1u;
+unsigned char input_held(void) {
+    return g_held;
+}
 
-    *CIA1_PRA = save;
-    return down;
+unsigned char input_pressed(void) {
+    return g_pressed;
 }
 
-// Detects a *new physical press* of the 'P' key, used to trigger the pause state.
-// Returns 1 exactly once per real press of 'P' (edge detection).
-// Requires the key to be fully released before it can trigger again.
-unsigned char input_pause_press(void) {   // P only
-    static unsigned char armed = 1u;
+// 1 if turning from 'from' to 'to' is a real turn (not a repeat, not 180°)
+static unsigned char turn_ok(Direction from, Direction to) {
+    if (to == from) return 0u;
+    if (from == DIR_UP    && to == DIR_DOWN)  return 0u;
+    if (from == DIR_DOWN  && to == DIR_UP)    return 0u;
+    if (from == DIR_LEFT  && to == DIR_RIGHT) return 0u;
+    if (from == DIR_RIGHT && to == DIR_LEFT)  return 0u;
+    return 1u;
+}
 
-    if (!armed) {
-        // Wait for full release
-        if (!raw_p_down()) armed = 1u;
-        return 0u;
-    }
+// Append a turn if it is valid after the last queued one (or the current dir)
+static void turn_push(Direction cur, Direction want) {
+    if (g_turn_n >= (unsigned char)TURNQ_SIZE) return;
 
-    // Rising-edge from your keyboard driver (press event)
-    if (keyboard_key_pressed(KEY_P)) {
-        // Disarm until release
-        armed = 0u;
-        return 1u;
+    unsigned char tail = (unsigned char)(g_turn_head + g_turn_n);
+    if (tail >= (unsigned char)TURNQ_SIZE) tail -= (unsigned char)TURNQ_SIZE;
+
+    // Direction the snake will have once everything queued has been applied
+    Direction last = cur;
+    if (g_turn_n != 0u) {
+        unsigned char prev = tail;
+        if (prev == 0u) prev = (unsigned char)TURNQ_SIZE;
+        last = g_turns[prev - 1u];
     }
-    return 0u;
+    if (!turn_ok(last, want)) return;
+
+    g_turns[tail] = want;
+    g_turn_n++;
 }
 
-// Detects a *new physical press* of the SPACE key, used to trigger the unpause state.
-// Returns 1 exactly once per real press of SPACE (edge detection).
-// Requires the key to be fully released before it can trigger again.
-unsigned char input_unpause_press(void) { // SPACE only
-    static unsigned char armed = 1u;
+// Queue the direction keys that went down at the latest scan
+void input_update(const Direction* dir) {
+    unsigned char pressed = g_pressed;
+    if ((pressed & (IN_UP | IN_DOWN | IN_LEFT | IN_RIGHT)) == 0u) return;
+
+    // Two keys in the same frame queue in a fixed order
+    Direction cur = *dir;
+    if (pressed & IN_UP)    turn_push(cur, DIR_UP);
+    if (pressed & IN_DOWN)  turn_push(cur, DIR_DOWN);
+    if (pressed & IN_LEFT)  turn_push(cur, DIR_LEFT);
+    if (pressed & IN_RIGHT) turn_push(cur, DIR_RIGHT);
+}
 
-    if (!armed) {
-        // Wait for full release
-        if (!raw_space_down()) armed = 1u;
-        return 0u;
-    }
+// Pop the oldest turn into *dir (already validated against its predecessor)
+void input_next_turn(Direction* dir) {
+    if (g_turn_n == 0u) return;
 
-    if (keyboard_key_pressed(KEY_SPACE)) {
-        // Disarm until release
-        armed = 0u;
-        return 1u;
-    }
-    return 0u;
+    *dir = g_turns[g_turn_head];
+    if (++g_turn_head >= (unsigned char)TURNQ_SIZE) g_turn_head = 0u;
+    g_turn_n--;
 }
 
+Direction input_peek_turn(Direction cur) {
+    if (g_turn_n == 0u) return cur;
+    return g_turns[g_turn_head];
+}
 
+// 1 on the frame 'P' goes down
+// Replay builds never pause: it would shift moves against seconds (replay.h)
+unsigned char input_pause_press(void) {
+#ifdef REPLAY
+    return 0u;
+#else
+    if (g_pressed & IN_PAUSE) return 1u;
+    return 0u;
+#endif
+}
 
+// 1 on the frame SPACE (or fire) goes down
+unsigned char input_unpause_press(void) {
+    if (g_pressed & IN_FIRE) return 1u;
+    return 0u;
+}
@@ -2,26 +2,59 @@
 #define INPUT_H
 
 // input.h
-// Keyboard input interface for Snake (WASD control + reversal lock)
+// Input for Snake: one keyboard/joystick scan per frame into a key bitmask
+// (WASD steering through a per-move turn queue, P pause, SPACE/fire, R restart)
 
 #include "snake.h"   // re-use Direction enum from snake.h
 
-// Initialize keyboard input system
-// - Sets up the C64 keyboard driver
-// - Initializes direction state and visual border color
+// Key bits in input_held() / input_pressed()
+// Joystick port 2 maps onto the same bits (stick = direction, fire = SPACE)
+#define IN_UP       0x01u   // W
+#define IN_DOWN     0x02u   // S
+#define IN_LEFT     0x04u   // A
+#define IN_RIGHT    0x08u   // D
+#define IN_FIRE     0x10u   // SPACE
+#define IN_PAUSE    0x20u   // P
+#define IN_RESTART  0x40u   // R
+
+// Depth of the turn queue (turns pressed ahead of the next moves)
+#ifndef TURNQ_SIZE
+#define TURNQ_SIZE 3u
+#endif
+
+// Initialize input state for a new game
+// - Empties the turn queue
+// - Sets the visual border color
 void input_init(void);
 
-// Poll keyboard and update movement direction
-// - Reads WASD keys for direction control
-// - Prevents 180° instant reversal (up/down, left/right)
-void input_update(Direction* dir);
+// Read the keyboard rows for W/A/S/D/P/SPACE/R and joystick port 2 once.
+// Call once per frame (frame_sync_and_input() does); everything below reads
+// the result of the latest scan
+void input_scan(void);
+
+// Keys held at the latest scan (IN_* bits)
+unsigned char input_held(void);
+
+// Keys that went down at the latest scan (IN_* bits, one frame per press)
+unsigned char input_pressed(void);
+
+// Queue the turns pressed at the latest scan (W/A/S/D or joystick).
+// Each turn is checked against the direction the snake will have when it is
+// applied (the last queued turn, or *dir): repeats and 180° reversals are
+// dropped, so quick taps such as UP then LEFT both land on successive moves.
+// Does not change *dir; see input_next_turn()
+void input_update(const Direction* dir);
+
+// Apply the oldest queued turn to *dir (once per move, before it is made)
+void input_next_turn(Direction* dir);
+
+// Direction the next move will use: the oldest queued turn, else 'cur'
+Direction input_peek_turn(Direction cur);
 
 // Returns 1 exactly once per *physical* press of 'P' (edge detection).
-// Requires the key to be fully released before it can trigger again.
 unsigned char input_pause_press(void);
 
-// Returns 1 exactly once per *physical* press of SPACE (edge detection).
-// Requires the key to be fully released before it can trigger again.
+// Returns 1 exactly once per *physical* press of SPACE or fire (edge detection).
 unsigned char input_unpause_press(void);
 
 
@@ -1,31 +1,54 @@
 #include "pause.h"
 
-// Pause state and time-bias (keeps HUD time correct)
+// Pause state and the pause-adjusted game clock
 // g_paused: 0=running, 1=paused
-static unsigned char g_paused      = 0u;
-// accumulated paused seconds
-static unsigned int  g_pause_bias  = 0u;
-// wall seconds at the moment we paused (to compute pause duration)
-static unsigned int  g_pause_start = 0u;
+static unsigned char g_paused   = 0u;
+// game seconds (binary), counts only unpaused seconds
+static unsigned int  g_game_sec = 0u;
+// same clock in packed BCD: [0]=SS (00..59), [1]=MM low pair, [2]=MM high pair
+static unsigned char g_clock[3];
 
-// paused=0, bias=0, start=0
+// Packed-BCD increment of one byte (99 wraps to 00)
+// On the C64 this is a single ADC in decimal mode; IRQs are held off so a
+// handler never runs with the D flag set
+static unsigned char bcd_inc(unsigned char v) {
+#ifdef HAL_HOST
+    v++;
+    if ((v & 0x0Fu) == 0x0Au) v += 6u;
+    if (v == 0xA0u) v = 0u;
+    return v;
+#else
+    asm {
+        php
+        sei
+        sed
+        clc
+        lda v
+        adc #1
+        sta v
+        cld
+        plp
+    }
+    return v;
+#endif
+}
+
+// paused=0, clock=0
 void pause_reset(void) {
-    g_paused      = 0u;
-    g_pause_bias  = 0u;
-    g_pause_start = 0u;
+    g_paused   = 0u;
+    g_game_sec = 0u;
+    g_clock[0] = 0u;
+    g_clock[1] = 0u;
+    g_clock[2] = 0u;
 }
 
-// set paused=1, remember start=timer_seconds()
+// set paused=1
 void pause_begin(void) {
-    g_paused      = 1u;
-    g_pause_start = timer_seconds();
+    g_paused = 1u;
 }
 
-// set paused=0, bias += (timer_seconds()-start)
+// set paused=0
 void pause_end_and_account(void) {
-    unsigned int now = timer_seconds();
-    unsigned int dur = (unsigned int)(now - g_pause_start);
-    g_pause_bias = (unsigned int)(g_pause_bias + dur);
     g_paused = 0u;
 }
 
@@ -34,9 +57,33 @@ unsigned char pause_is_paused(void) {
     return g_paused;
 }
 
-// wall seconds minus total paused bias
+// unpaused seconds since pause_reset()
 unsigned int game_seconds(void) {
-    return (unsigned int)(timer_seconds() - g_pause_bias);
+    return g_game_sec;
+}
+
+// Advance the game clock by one second (binary and BCD)
+// The BCD clock stops at 9999:59
+void game_clock_tick(void) {
+    if (g_clock[2] == 0x99u) {
+        if (g_clock[1] == 0x99u) {
+            if (g_clock[0] == 0x59u) return;
+        }
+    }
+    g_game_sec++;
+
+    unsigned char ss = bcd_inc(g_clock[0]);
+    if (ss == 0x60u) {
+        ss = 0u;
+        g_clock[1] = bcd_inc(g_clock[1]);
+        if (g_clock[1] == 0u) g_clock[2] = bcd_inc(g_clock[2]);
+    }
+    g_clock[0] = ss;
+}
+
+// BCD game clock [SS, MM low, MM high]
+const unsigned char* game_clock(void) {
+    return g_clock;
 }
 
 // if paused, clear any 1s edge (to avoid instant tick on unpause)
@@ -3,21 +3,28 @@
 
 #include "timer.h"
 
-// paused=0, bias=0, start=0
+// paused=0, clock=0
 void pause_reset(void);
 
-// set paused=1, remember start=timer_seconds()
+// set paused=1 (the game clock stops)
 void pause_begin(void);
 
-// set paused=0, bias += (timer_seconds()-start)
+// set paused=0 (the game clock runs again)
 void pause_end_and_account(void);
 
 // 1 if currently paused, else 0
 unsigned char pause_is_paused(void);
 
-// wall seconds minus total paused bias
+// unpaused seconds since pause_reset() (binary)
 unsigned int game_seconds(void);
 
+// Advance the game clock by one second; call on each unpaused second edge
+void game_clock_tick(void);
+
+// Game clock in packed BCD: [0]=seconds 00..59, [1]=minutes low pair,
+// [2]=minutes high pair (so up to 9999:59)
+const unsigned char* game_clock(void);
+
 // if paused, clear any 1s edge (to avoid instant tick on unpause)
 void pause_drain_second_edge(void);
 
@@ -0,0 +1,38 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+// profile.h
+// Raster-bar profiling: build with -DPROFILE_RASTER to paint the border in a
+// per-subsystem colour while that subsystem runs. The height of each colour
+// band on screen is the share of the frame it used. Without the flag every
+// PROF_* macro expands to nothing.
+
+// Phase colours (C64 palette)
+#define PROF_COL_IDLE     0u   // black: waiting for the next frame
+#define PROF_COL_INPUT    5u   // green: input_update()
+#define PROF_COL_MOVE     2u   // red: next head, collision, step
+#define PROF_COL_FOOD     7u   // yellow: food_handle_eat_grow()
+#define PROF_COL_RENDER  14u   // light blue: render queue flush / step draw
+#define PROF_COL_HUD      4u   // purple: hud_tick()
+
+#ifdef PROFILE_RASTER
+
+#include "hal.h"
+
+// Border register through the HAL
+#define PROF_BORDER  HAL_BORDER
+
+// Enter a phase: paint the border in the phase colour
+#define PROF_BEGIN(col)  PROF_BORDER = (col)
+
+// Leave a phase: back to the idle colour
+#define PROF_END()       PROF_BORDER = PROF_COL_IDLE
+
+#else
+
+#define PROF_BEGIN(col)
+#define PROF_END()
+
+#endif
+
+#endif
@@ -2,18 +2,25 @@
 // C64 text-mode renderer for Snake:
 // - Fast 40x25 screen addressing helpers
 // - Full/step/grow snake drawing
-// - HUD time printer (mm:ss) without division/modulo
-// - Simple “Game Over” screen
+// - HUD clock from packed BCD, redrawing only changed digits
+// - Title, Game Over and pause screens unpacked from screens.c
 // - Food drawing and playfield clear/erase
+// - Deferred cell-command queue, flushed once per frame in the lower border
+// - Optional page flipping between two screens (-DSCREEN_DOUBLE)
+// - Optional ECM mode (-DRENDER_ECM): colours live in the screen codes and
+//   colour RAM is painted once, so cell updates are one store
 
-#include <c64.h>
 #include "render.h"
+#include "screens.h"
+
+// Forget the HUD clock digits on screen (defined with the HUD clock below)
+static void clock_invalidate(void);
 
 /* --------------------------------------------------------------------
    Fast row offsets: off = row_off[y] + x  (avoids 16-bit multiply)
    MAP_W is 40 on C64 text mode.
 -------------------------------------------------------------------- */
-static const unsigned int row_off[MAP_H] = {
+static HAL_ALIGN(0x40) const unsigned int row_off[MAP_H] = {
     0*MAP_W,  1*MAP_W,  2*MAP_W,  3*MAP_W,  4*MAP_W,
     5*MAP_W,  6*MAP_W,  7*MAP_W,  8*MAP_W,  9*MAP_W,
    10*MAP_W, 11*MAP_W, 12*MAP_W, 13*MAP_W, 14*MAP_W,
@@ -21,6 +28,176 @@ static const unsigned int row_off[MAP_H] = {
    20*MAP_W, 21*MAP_W, 22*MAP_W, 23*MAP_W, 24*MAP_W
 };
 
+/* --------------------------------------------------------------------
+   Render command queue
+   In-game cell writes (step, grow, food, HUD time) are appended here and
+   written to SCREEN/COLOR_RAM by render_flush() in one tight loop while the
+   beam is in the lower border. A full queue is flushed early (never dropped).
+-------------------------------------------------------------------- */
+#define RQ_SIZE 32
+
+// Queue arrays never straddle a page; the count lives in zero page
+static HAL_ALIGN(0x40) unsigned int  rq_off[RQ_SIZE];
+static HAL_ALIGN(0x20) unsigned char rq_ch[RQ_SIZE];
+#ifndef RENDER_ECM
+static HAL_ALIGN(0x20) unsigned char rq_col[RQ_SIZE];
+#endif
+static HAL_ZP unsigned char rq_n = 0;
+
+// Flush statistics: deepest queue and longest flush (raster lines) seen
+static unsigned char rq_peak = 0;
+static unsigned char rq_flush_lines_max = 0;
+
+#ifdef SCREEN_DOUBLE
+// Drawing screen (the hidden one) and the colour image of the next present
+unsigned char* render_back = HAL_SCREEN_B;
+#ifndef RENDER_ECM
+HAL_ALIGN(0x100) unsigned char render_back_color[MAP_W*MAP_H];
+#endif
+#endif
+
+#ifdef SPRITE_HEAD
+/* --------------------------------------------------------------------
+   Sprite head (build with -DSPRITE_HEAD)
+   Sprite 0 draws the head as an 8x8 block that glides from the head cell
+   toward the next cell every frame. render_head_sprite() only computes the
+   position; render_flush() writes it to the VIC-II in the lower border.
+   Body cells are still committed to the screen on whole-cell steps.
+-------------------------------------------------------------------- */
+
+// Screen origin of cell (0,0) in sprite coordinates (PAL, 25 rows, 40 columns)
+#define SPR_X0 24u
+#define SPR_Y0 50u
+
+// Pending sprite state: 9-bit X, Y, shown flag, and whether it changed
+static unsigned int  g_spr_x = 0u;
+static unsigned char g_spr_y = 0u;
+static unsigned char g_spr_on = 0u;
+static unsigned char g_spr_dirty = 0u;
+static unsigned char g_spr_ready = 0u;
+
+// One-time sprite image (8x8 solid block in the top-left corner), pointer, colour
+static void head_sprite_setup(void) {
+    unsigned char* d = HAL_SPRITE_DATA;
+    for (unsigned char i = 0u; i != 64u; ++i) d[i] = 0u;
+    for (unsigned char r = 0u; r != 8u; ++r) d[r * 3u] = 0xFFu;
+    g_spr_ready = 1u;
+}
+
+// Write the pending sprite state to the VIC-II (called from render_flush)
+static void head_sprite_commit(void) {
+    if (!g_spr_dirty) return;
+    g_spr_dirty = 0u;
+
+    if (!g_spr_on) {
+        HAL_SPR_ENABLE &= 0xFEu;
+        return;
+    }
+    HAL_SPR_PTRS[0] = HAL_SPRITE_BLOCK;
+#ifdef SCREEN_DOUBLE
+    HAL_SPR_PTRS_B[0] = HAL_SPRITE_BLOCK;
+#endif
+    HAL_SPR0_COL = COL_SNAKE;
+    HAL_SPR0_X = (unsigned char)g_spr_x;
+    HAL_SPR0_Y = g_spr_y;
+    if (g_spr_x >= 256u) HAL_SPR_XMSB |= 0x01u;
+    else                 HAL_SPR_XMSB &= 0xFEu;
+    HAL_SPR_ENABLE |= 0x01u;
+}
+
+void render_head_sprite(unsigned char x, unsigned char y, Direction dir, unsigned char frac) {
+    if (!g_spr_ready) head_sprite_setup();
+
+    // Pixels travelled toward the next cell: fraction 0..255 -> 0..7
+    unsigned char off = frac >> 5;
+
+    unsigned int sx = SPR_X0 + ((unsigned int)x << 3);
+    unsigned char sy = (unsigned char)(SPR_Y0 + (y << 3));
+    if (dir == DIR_RIGHT)     sx += off;
+    else if (dir == DIR_LEFT) sx -= off;
+    else if (dir == DIR_DOWN) sy += off;
+    else                      sy -= off;
+
+    if (sx != g_spr_x || sy != g_spr_y || !g_spr_on) {
+        g_spr_x = sx;
+        g_spr_y = sy;
+        g_spr_on = 1u;
+        g_spr_dirty = 1u;
+    }
+}
+
+void render_head_sprite_hide(void) {
+    g_spr_on = 0u;
+    g_spr_dirty = 0u;
+    HAL_SPR_ENABLE &= 0xFEu;
+}
+#endif
+
+void render_flush(void) {
+#ifdef SPRITE_HEAD
+    // Head sprite position (a few register writes, also while the queue is empty)
+    head_sprite_commit();
+#endif
+
+    unsigned char n = rq_n;
+    if (n == 0) return;
+
+    unsigned int start = hal_raster_line();
+
+    for (unsigned char i = 0; i != n; ++i) {
+        unsigned int off = rq_off[i];
+#ifdef SCREEN_DOUBLE
+        // Both screens and the colour image stay in step with the display
+        unsigned char ch  = rq_ch[i];
+        HAL_SCREEN[off]        = ch;
+        HAL_SCREEN_B[off]      = ch;
+#ifndef RENDER_ECM
+        unsigned char col = rq_col[i];
+        HAL_COLOR_RAM[off]     = col;
+        render_back_color[off] = col;
+#endif
+#else
+        SCREEN[off]    = rq_ch[i];
+#ifndef RENDER_ECM
+        COLOR_RAM[off] = rq_col[i];
+#endif
+#endif
+    }
+    rq_n = 0;
+
+    // Lines spent (PAL frame is 312 lines; the flush never spans a frame)
+    unsigned int end = hal_raster_line();
+    if (end < start) end += 312u;
+    unsigned int lines = end - start;
+    if (lines > 255u) lines = 255u;
+    if ((unsigned char)lines > rq_flush_lines_max) rq_flush_lines_max = (unsigned char)lines;
+}
+
+// Queued cell write: flushes early if the queue is full
+static void rq_put(unsigned int off, unsigned char ch, unsigned char col) {
+    if (rq_n == (unsigned char)RQ_SIZE) render_flush();
+    unsigned char i = rq_n;
+    rq_off[i] = off;
+    rq_ch[i]  = ch;
+#ifndef RENDER_ECM
+    rq_col[i] = col;
+#else
+    HAL_UNUSED(col);
+#endif
+    rq_n = (unsigned char)(i + 1);
+    if (rq_n > rq_peak) rq_peak = rq_n;
+}
+
+// Drop pending commands (the screen is about to be cleared anyway)
+static void rq_discard(void) {
+    rq_n = 0;
+}
+
+void render_flush_stats(unsigned char* out_lines_max, unsigned char* out_peak) {
+    *out_lines_max = rq_flush_lines_max;
+    *out_peak      = rq_peak;
+}
+
 /* --------------------------------------------------------------------
    Low-level helpers
 -------------------------------------------------------------------- */
@@ -28,18 +205,10 @@ static inline unsigned int paddr(unsigned char x, unsigned char y) {
     return row_off[y] + x;
 }
 
-static inline void pset(unsigned char x, unsigned char y,
-                        unsigned char ch, unsigned char col) {
-    unsigned int off = paddr(x, y);
-    SCREEN[off]    = ch;
-    COLOR_RAM[off] = col;
-}
-
+// Queued character write (HUD text)
 static inline void pchar(unsigned char x, unsigned char y,
                          unsigned char ch, unsigned char col) {
-    unsigned int off = paddr(x, y);
-    SCREEN[off]    = ch;
-    COLOR_RAM[off] = col;
+    rq_put(paddr(x, y), ch, col);
 }
 
 /* --------------------------------------------------------------------
@@ -48,56 +217,312 @@ static inline void pchar(unsigned char x, unsigned char y,
 -------------------------------------------------------------------- */
 void render_clear() {
     // Set light blue border color
-    VICII->BORDER_COLOR = 14;
+    HAL_BORDER = 14;
 
     // Set classic blue background color
     clear_battlefield();
 }
 
+#ifdef RENDER_ECM
+static unsigned char g_ecm_ready = 0u;
+
+// One-time ECM setup (before the first screen): snake and food colours in
+// background colours 1-3, ECM on, colour RAM white for all text from now on.
+// $D011 bit 7 (raster compare bit 8) is written as 0, as sys_init() does
+static void ecm_setup(void) {
+    HAL_BG1 = COL_SNAKE;
+    HAL_BG2 = COL_FOOD;
+    HAL_BG3 = COL_FOOD_BONUS;
+    HAL_VIC_CTRL1 = (unsigned char)((HAL_VIC_CTRL1 & 0x7F) | HAL_ECM_BIT);
+    render_fill_color(COL_FG_WHITE);
+    g_ecm_ready = 1u;
+}
+#endif
+
+// Before the whole screen is replaced: anything still queued would land on
+// the new screen, and the clock digits must be redrawn on it
+static void screen_forget(void) {
+#ifdef RENDER_ECM
+    if (!g_ecm_ready) ecm_setup();
+#endif
+    rq_discard();
+    clock_invalidate();
+#ifdef SPRITE_HEAD
+    render_head_sprite_hide();
+#endif
+}
+
 void clear_battlefield()
 {
-    VICII->BG_COLOR = 6;
-
-    // Clear 40x25: character = space, color = white
-    // (two tight loops avoid 16-bit multiply in the body)
-    unsigned int off = 0;
-    for (unsigned char y = 0; y < MAP_H; ++y)
-    {
-        for (unsigned char x = 0; x < MAP_W; ++x, ++off)
-        {
-            SCREEN[off] = CH_EMPTY;
-            COLOR_RAM[off] = COL_FG_WHITE;
+    HAL_BG = 6;
+    screen_forget();
+
+    // Clear 40x25: character = space, color = white (ECM: already white)
+    render_fill_screen(CH_EMPTY);
+#ifndef RENDER_ECM
+    render_fill_color(COL_FG_WHITE);
+#endif
+}
+
+/* --------------------------------------------------------------------
+   Block primitives: the 1000 cells are handled as four 250-byte runs
+   (offsets 0, 250, 500, 750) so the loop index stays 8-bit and each store
+   is a single absolute,X (or (zp),Y) instruction.
+-------------------------------------------------------------------- */
+#define RUN 250
+
+void render_fill_screen(unsigned char ch) {
+    unsigned char i = 0;
+    do {
+        SCREEN[i]         = ch;
+        SCREEN[RUN+i]     = ch;
+        SCREEN[2*RUN+i]   = ch;
+        SCREEN[3*RUN+i]   = ch;
+        ++i;
+    } while (i != (unsigned char)RUN);
+}
+
+void render_fill_color(unsigned char col) {
+    unsigned char i = 0;
+    do {
+        COLOR_RAM[i]       = col;
+        COLOR_RAM[RUN+i]   = col;
+        COLOR_RAM[2*RUN+i] = col;
+        COLOR_RAM[3*RUN+i] = col;
+        ++i;
+    } while (i != (unsigned char)RUN);
+}
+
+void render_copy_image(const unsigned char* scr, const unsigned char* col) {
+    const unsigned char* s1 = scr + RUN;
+    const unsigned char* s2 = scr + 2*RUN;
+    const unsigned char* s3 = scr + 3*RUN;
+#ifndef RENDER_ECM
+    const unsigned char* c1 = col + RUN;
+    const unsigned char* c2 = col + 2*RUN;
+    const unsigned char* c3 = col + 3*RUN;
+#else
+    HAL_UNUSED(col);
+#endif
+    unsigned char i = 0;
+    do {
+        SCREEN[i]          = scr[i];
+        SCREEN[RUN+i]      = s1[i];
+        SCREEN[2*RUN+i]    = s2[i];
+        SCREEN[3*RUN+i]    = s3[i];
+#ifndef RENDER_ECM
+        COLOR_RAM[i]       = col[i];
+        COLOR_RAM[RUN+i]   = c1[i];
+        COLOR_RAM[2*RUN+i] = c2[i];
+        COLOR_RAM[3*RUN+i] = c3[i];
+#endif
+        ++i;
+    } while (i != (unsigned char)RUN);
+}
+
+void render_save_image(unsigned char* scr, unsigned char* col) {
+    unsigned char* s1 = scr + RUN;
+    unsigned char* s2 = scr + 2*RUN;
+    unsigned char* s3 = scr + 3*RUN;
+#ifndef RENDER_ECM
+    unsigned char* c1 = col + RUN;
+    unsigned char* c2 = col + 2*RUN;
+    unsigned char* c3 = col + 3*RUN;
+#else
+    HAL_UNUSED(col);
+#endif
+    unsigned char i = 0;
+    do {
+        scr[i] = SCREEN[i];
+        s1[i]  = SCREEN[RUN+i];
+        s2[i]  = SCREEN[2*RUN+i];
+        s3[i]  = SCREEN[3*RUN+i];
+#ifndef RENDER_ECM
+        col[i] = COLOR_RAM[i];
+        c1[i]  = COLOR_RAM[RUN+i];
+        c2[i]  = COLOR_RAM[2*RUN+i];
+        c3[i]  = COLOR_RAM[3*RUN+i];
+#endif
+        ++i;
+    } while (i != (unsigned char)RUN);
+}
+
+#ifdef SCREEN_DOUBLE
+/* --------------------------------------------------------------------
+   Page flip: the VIC-II shows render_back from the next frame on
+-------------------------------------------------------------------- */
+void render_present(void) {
+    unsigned char* front = render_back;
+    unsigned char i;
+
+    // Queued updates first (they go to both screens), then the lower border
+    render_flush();
+    hal_wait_raster_wrap();
+    hal_screen_show((unsigned char)(front == HAL_SCREEN_B));
+
+#ifndef RENDER_ECM
+    // Colours top to bottom, one run after the other: the beam reaches row 0
+    // about 100 lines from now and then gains less than a row per row
+    // copied, so every row is written before it is shown
+    i = 0;
+    do { HAL_COLOR_RAM[i] = render_back_color[i]; ++i; } while (i != (unsigned char)RUN);
+    i = 0;
+    do { HAL_COLOR_RAM[RUN+i] = render_back_color[RUN+i]; ++i; } while (i != (unsigned char)RUN);
+    i = 0;
+    do { HAL_COLOR_RAM[2*RUN+i] = render_back_color[2*RUN+i]; ++i; } while (i != (unsigned char)RUN);
+    i = 0;
+    do { HAL_COLOR_RAM[3*RUN+i] = render_back_color[3*RUN+i]; ++i; } while (i != (unsigned char)RUN);
+#endif
+
+    // The other screen is drawn next: bring it up to date (it is hidden)
+    render_back = (front == HAL_SCREEN_B) ? HAL_SCREEN : HAL_SCREEN_B;
+    i = 0;
+    do {
+        SCREEN[i]       = front[i];
+        SCREEN[RUN+i]   = front[RUN+i];
+        SCREEN[2*RUN+i] = front[2*RUN+i];
+        SCREEN[3*RUN+i] = front[3*RUN+i];
+        ++i;
+    } while (i != (unsigned char)RUN);
+}
+#endif
+
+/* --------------------------------------------------------------------
+   Packed screens (screens.c, built from assets/ by tools/mkscreens.c)
+   A stream of runs: $01-$7F literal bytes, $81-$FF one repeated byte,
+   $80 skipped cells, $00 end. Each run is one 8-bit indexed loop, then the
+   pointers move on by its length.
+-------------------------------------------------------------------- */
+static const unsigned char* unpack(unsigned char* dst, const unsigned char* src) {
+    unsigned char op = *src;
+    while (op != 0u) {
+        unsigned char n = (unsigned char)(op & 0x7Fu);
+        unsigned char i = 0;
+        if (op == 0x80u) {
+            // Skip: keep what is on screen
+            dst += src[1];
+            src += 2;
+        } else if (op & 0x80u) {
+            // Run of one byte
+            unsigned char v = src[1];
+            do {
+                dst[i] = v;
+                ++i;
+            } while (i != n);
+            dst += n;
+            src += 2;
+        } else {
+            // Literal bytes
+            ++src;
+            do {
+                dst[i] = src[i];
+                ++i;
+            } while (i != n);
+            dst += n;
+            src += n;
         }
+        op = *src;
     }
+    return src + 1;
+}
+
+// Unpack a screen: screen codes, then colours (ECM: all text stays white)
+static void show_packed(const unsigned char* packed) {
+#ifndef RENDER_ECM
+    unpack(COLOR_RAM, unpack(SCREEN, packed));
+#else
+    unpack(SCREEN, packed);
+#endif
 }
 
 /* --------------------------------------------------------------------
    Snake rendering
 -------------------------------------------------------------------- */
 void render_draw_snake_full(const Snake* s) {
-    unsigned char i;
-    for (i = 0; i < s->len; ++i) {
-        unsigned int off = (unsigned int)s->y[i] * MAP_W + s->x[i];
+    // Direct full redraw: land queued updates first to keep write order
+    render_flush();
+
+    // Walk the body from tail to head (cells are screen offsets)
+    SnakeWalk w;
+    unsigned int n;
+    snake_walk_begin(s, &w);
+    for (n = s->len; n != 0; n = n - 1u) {
+        unsigned int off = snake_walk_next(s, &w);
         SCREEN[off]    = CH_SNAKE;
+#ifndef RENDER_ECM
         COLOR_RAM[off] = COL_SNAKE;
+#endif
     }
 }
 
-void render_apply_step(unsigned char tail_x, unsigned char tail_y,
-                       unsigned char head_x, unsigned char head_y) {
+void render_apply_step(Cell tail, Cell head) {
     // Erase the old tail
-    pset(tail_x, tail_y, CH_EMPTY, COL_FG_WHITE);
+    rq_put(tail, CH_EMPTY, COL_FG_WHITE);
+
+    // The tail left a clock cell (row 0, "MMMM:SS" at most): the clock is
+    // redrawn in full at the next second
+    if (tail < 7u) clock_invalidate();
 
     // Draw new head
-    pset(head_x, head_y, CH_SNAKE, COL_SNAKE);
+    rq_put(head, CH_SNAKE, COL_SNAKE);
 }
 
 /* --------------------------------------------------------------------
-   HUD: mm:ss printer without / or % (keeps it branch-light)
+   HUD clock: packed-BCD digits, written only where they changed
 -------------------------------------------------------------------- */
 
+// Screen code of an ASCII HUD character: 'A'..'Z' -> 1..26 (as mkscreens
+// converts), digits, ':' and space unchanged; always below 64, so ECM
+// (-DRENDER_ECM) shows every HUD character on the normal background
+static inline unsigned char hud_code(unsigned char ch) {
+    return (unsigned char)(ch & 0x3Fu);
+}
+
+// Queue an ASCII HUD character at (x,0) in white
+static inline void hud_put(unsigned char x, unsigned char ch) {
+    pchar(x, 0, hud_code(ch), COL_FG_WHITE);
+}
+
+// Last drawn clock bytes [SS, MM low, MM high]; 0xFF = not on screen
+static unsigned char g_clock_shown[3] = { 0xFFu, 0xFFu, 0xFFu };
+
+// Forget what the HUD shows (after the screen was cleared)
+static void clock_invalidate(void) {
+    g_clock_shown[0] = 0xFFu;
+    g_clock_shown[1] = 0xFFu;
+    g_clock_shown[2] = 0xFFu;
+}
+
+// Queue the digits of BCD pair 'v' at (x,0) that differ from 'old'
+static void clock_pair(unsigned char x, unsigned char v, unsigned char old) {
+    unsigned char d = v ^ old;
+    if (d & 0xF0u) hud_put(x,     (unsigned char)('0' + (v >> 4)));
+    if (d & 0x0Fu) hud_put(x + 1, (unsigned char)('0' + (v & 0x0Fu)));
+}
+
+void render_draw_clock(const unsigned char* clock) {
+    unsigned char x = 0;
+    unsigned char hi = clock[2];
+
+    // From 100 minutes on the minutes take four digits: the layout widens once
+    if (hi != 0u) {
+        if (g_clock_shown[2] == 0u) clock_invalidate();
+        clock_pair(0, hi, g_clock_shown[2]);
+        x = 2;
+    }
+
+    if (g_clock_shown[0] == 0xFFu) hud_put(x + 2, ':');
+    clock_pair(x,     clock[1], g_clock_shown[1]);
+    clock_pair(x + 3, clock[0], g_clock_shown[0]);
+
+    g_clock_shown[0] = clock[0];
+    g_clock_shown[1] = clock[1];
+    g_clock_shown[2] = hi;
+}
+
+// Digit tables for the two-digit stats below
 // Lookup table for tens digit of 0..99
-static const unsigned char DIG_TENS[100] = {
+static HAL_ALIGN(0x80) const unsigned char DIG_TENS[100] = {
   0,0,0,0,0,0,0,0,0,0, 1,1,1,1,1,1,1,1,1,1,
   2,2,2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3,3,3,
   4,4,4,4,4,4,4,4,4,4, 5,5,5,5,5,5,5,5,5,5,
@@ -106,108 +531,95 @@ static const unsigned char DIG_TENS[100] = {
 };
 
 // Lookup table for ones digit of 0..99
-static const unsigned char DIG_ONES[100] = {
+static HAL_ALIGN(0x80) const unsigned char DIG_ONES[100] = {
   0,1,2,3,4,5,6,7,8,9, 0,1,2,3,4,5,6,7,8,9,
   0,1,2,3,4,5,6,7,8,9, 0,1,2,3,4,5,6,7,8,9,
   0,1,2,3,4,5,6,7,8,9, 0,1,2,3,4,5,6,7,8,9,
   0,1,2,3,4,5,6,7,8,9, 0,1,2,3,4,5,6,7,8,9
 };
 
-void render_draw_mmss_at(unsigned char x, unsigned char y, unsigned int total_seconds) {
-    // Convert total_seconds to mm:ss (0..99:59) using subtract loop to avoid division
-    unsigned int secs = total_seconds;
-    unsigned char mm = 0;
-    while (secs >= 60u) { secs -= 60u; if (mm < 99) mm++; else break; }
-    unsigned char ss = (unsigned char)secs;
-
-    unsigned char mt = DIG_TENS[mm], mo = DIG_ONES[mm];
-    unsigned char st = DIG_TENS[ss], so = DIG_ONES[ss];
-
-    pchar(x+0, y, (unsigned char)('0'+mt), COL_FG_WHITE);
-    pchar(x+1, y, (unsigned char)('0'+mo), COL_FG_WHITE);
-    pchar(x+2, y, ':',                       COL_FG_WHITE);
-    pchar(x+3, y, (unsigned char)('0'+st), COL_FG_WHITE);
-    pchar(x+4, y, (unsigned char)('0'+so), COL_FG_WHITE);
+// Draw a HUD stat "Tnn" at (x,0): tag letter + two digits (values above 99 show 99)
+void render_draw_stat(unsigned char x, unsigned char tag, unsigned char value) {
+    if (value > 99) value = 99;
+    hud_put(x,     tag);
+    hud_put(x + 1, (unsigned char)('0'+DIG_TENS[value]));
+    hud_put(x + 2, (unsigned char)('0'+DIG_ONES[value]));
 }
 
-void render_draw_time(unsigned int total_seconds) {
-    // Short, atomic HUD update (safe to call right after wait_frame()).
-    render_draw_mmss_at(0, 0, total_seconds);
+// Draw a five-digit HUD stat "Tnnnnn" (tag letter + 16-bit value) at (x,0)
+// Digits by repeated subtraction: no 16-bit division
+void render_draw_stat5(unsigned char x, unsigned char tag, unsigned int value) {
+    static const unsigned int POW10_16[4] = { 10000u, 1000u, 100u, 10u };
+    hud_put(x, tag);
+    for (unsigned char i = 0; i < 4u; ++i) {
+        unsigned char d = '0';
+        while (value >= POW10_16[i]) {
+            value -= POW10_16[i];
+            d++;
+        }
+        hud_put(x + 1 + i, d);
+    }
+    hud_put(x + 5, (unsigned char)('0' + value));
 }
 
-/* --------------------------------------------------------------------
-   Tiny text printer (PETSCII caveats: pass screen codes or uppercase)
--------------------------------------------------------------------- */
-static void print_text(unsigned char x, unsigned char y, const char* s) {
-    unsigned char cx = x;
-    while (*s) { pchar(cx++, y, (unsigned char)*s++, COL_FG_WHITE); }
+// Draw the flush stats "Fnn Qnn" at (33,0): longest flush in raster lines, deepest queue
+void render_draw_flush_stats(void) {
+    render_draw_stat(33, 'F', rq_flush_lines_max);
+    render_draw_stat(37, 'Q', rq_peak);
 }
 
 /* --------------------------------------------------------------------
-   Game Over screen
+   Game Over / board full screen
 -------------------------------------------------------------------- */
-void render_game_over(unsigned int total_seconds) {
-    // Clear the screen
-    clear_battlefield();
-
-    // Red border
-    VICII->BORDER_COLOR = 2u;
-
-    // Title & restart text (<=40 chars, uppercase)
-    static const char t_title[]   = "G A M E   O V E R";
-    static const char t_restart[] = "PRESS SPACE OR R TO RESTART";
-
-    // --- Build "TIME 00:00" as one centered string ---
-    // Convert total_seconds -> mm:ss with 8-bit compares only
-    unsigned int secs = total_seconds;
-    unsigned char mm  = 0;
+void render_game_over(const unsigned char* clock, unsigned char won) {
+    const unsigned char* packed = SCR_OVER;
+
+    // Red border, green when won
+    HAL_BORDER = 2u;
+    if (won) {
+        HAL_BORDER = 5u;
+        packed = SCR_WON;
+    }
 
-    while (secs >= 60u) {
-        if (mm == (unsigned char)99) {          // cap at 99 using 8-bit literal
-            break;
+    // Whole screen in one unpack (text is white on the blue background)
+    HAL_BG = 6;
+    screen_forget();
+    show_packed(packed);
+
+    // "TIME MM:SS" after the packed "TIME" (row 13, column 15), straight from
+    // the BCD clock: one nibble per digit. "TIME MMMM:SS" starts one cell
+    // further left to stay centered
+    unsigned int off = row_off[13] + 20u;
+    if (clock[2] != 0u) {
+        unsigned int t = row_off[13] + 15u;
+        for (unsigned char i = 0; i < 4u; ++i) {
+            SCREEN[t - 1u + i] = SCREEN[t + i];
         }
-        secs -= 60u;
-        mm = (unsigned char)(mm + 1);           // keep it 8-bit
+        SCREEN[t + 3u] = ' ';
+        off = off - 1u;
+        SCREEN[off++] = (unsigned char)('0' + (clock[2] >> 4));     // thousands of minutes
+        SCREEN[off++] = (unsigned char)('0' + (clock[2] & 0x0Fu));  // hundreds of minutes
     }
-    unsigned char ss = (unsigned char)secs;
-
-    // Buffer: "TIME 00:00\0" (length 10)
-    char t_time[11];
-    t_time[0]  = 'T';
-    t_time[1]  = 'I';
-    t_time[2]  = 'M';
-    t_time[3]  = 'E';
-    t_time[4]  = ' ';
-    t_time[5]  = (char)('0' + DIG_TENS[mm]);   // tens of minutes
-    t_time[6]  = (char)('0' + DIG_ONES[mm]);   // ones of minutes
-    t_time[7]  = ':';
-    t_time[8]  = (char)('0' + DIG_TENS[ss]);   // tens of seconds
-    t_time[9]  = (char)('0' + DIG_ONES[ss]);   // ones of seconds
-    t_time[10] = 0;
-
-    // Draw
-    print_centered(10, t_title,   1);  // white title
-    print_centered(13, t_time,    1);  // white time line (single centered string)
-    print_centered(18, t_restart, 7);  // yellow restart hint
+    SCREEN[off++] = (unsigned char)('0' + (clock[1] >> 4));         // tens of minutes
+    SCREEN[off++] = (unsigned char)('0' + (clock[1] & 0x0Fu));      // ones of minutes
+    SCREEN[off++] = ':';
+    SCREEN[off++] = (unsigned char)('0' + (clock[0] >> 4));         // tens of seconds
+    SCREEN[off]   = (unsigned char)('0' + (clock[0] & 0x0Fu));      // ones of seconds
+    render_present();
 }
 
-// Compute linear screen offset y*MAP_W + x (fits in 16-bit; KickC optimizes well)
-static inline unsigned int scr_off(unsigned char x, unsigned char y) {
-    return (unsigned int)y * MAP_W + x;
-}
+// Food glyph and colour per type (FOOD_PLAIN, FOOD_BONUS)
+static const unsigned char FOOD_CH[2]  = { CH_FOOD,  CH_FOOD_BONUS  };
+static const unsigned char FOOD_COL[2] = { COL_FOOD, COL_FOOD_BONUS };
 
-void render_draw_food(unsigned char x, unsigned char y) {
-    // Place the food glyph and its color at (x,y)
-    unsigned int off = scr_off(x,y);
-    SCREEN[off]    = CH_FOOD;
-    COLOR_RAM[off] = COL_FOOD;
+void render_draw_food(Cell c, unsigned char type) {
+    // Queue the food glyph and its color at cell c
+    rq_put(c, FOOD_CH[type], FOOD_COL[type]);
 }
 
 // Draw only the new head (used when growing: no tail erase)
-void render_apply_grow(unsigned char head_x, unsigned char head_y) {
-    unsigned int off = scr_off(head_x, head_y);
-    SCREEN[off]    = CH_SNAKE;
-    COLOR_RAM[off] = COL_SNAKE;
+void render_apply_grow(Cell head) {
+    rq_put(head, CH_SNAKE, COL_SNAKE);
 }
 
 // Playfield background character (space by default)
@@ -222,125 +634,57 @@ void render_apply_grow(unsigned char head_x, unsigned char head_y) {
 
 // Clear the whole playfield area to the background char/color
 void render_clear_playfield(void) {
-    // Clear the entire playfield to the background char/color
-    unsigned int off = 0;
-    unsigned char y, x;
-    for (y = 0; y < MAP_H; y++) {
-        for (x = 0; x < MAP_W; x++) {
-            // Background character for the cleared playfield (e.g., space)
-            SCREEN[off]    = CH_BG;
-
-            // Normal playfield color
-            COLOR_RAM[off] = COL_BG;
-
-            off++;
-        }
-    }
-}
+    screen_forget();
 
-// Replace a single cell with the playfield background
-void render_erase_cell(unsigned char x, unsigned char y) {
-    // Replace a single cell with the playfield background
-    unsigned int off = (unsigned int)y * MAP_W + x;
-
-    // Match the cleared playfield background character
-    SCREEN[off]    = CH_BG;
+    // Background character for the cleared playfield (e.g., space)
+    render_fill_screen(CH_BG);
 
-    // Match the cleared playfield background color
-    COLOR_RAM[off] = COL_BG;
+    // Normal playfield color (ECM: the background register does it)
+#ifndef RENDER_ECM
+    render_fill_color(COL_BG);
+#endif
 }
 
-// Clear a centered line by overwriting spaces (len = text length you drew)
-static void clear_centered_line(unsigned char row, unsigned char len) {
-    const unsigned char COLS = (unsigned char)40;
-    unsigned char col = (unsigned char)(((unsigned char)(COLS - len)) >> 1);
-    unsigned int off  = (unsigned int)row * 40u + (unsigned int)col;
-
-    while (len--) {
-        SCREEN[off]    = (unsigned char)32;  // space
-        COLOR_RAM[off] = (unsigned char)0;   // black (or keep prior if you prefer)
-        ++off;
-    }
+// Replace a single cell with the playfield background
+void render_erase_cell(Cell c) {
+    // Replace a single cell with the playfield background (queued)
+    rq_put(c, CH_BG, COL_BG);
 }
 
+// Playfield snapshot taken under the pause overlay (restored on resume)
+static unsigned char g_pause_scr[MAP_W*MAP_H];
+static unsigned char g_pause_col[MAP_W*MAP_H];
+
 // Show the pause overlay (does NOT clear the whole screen)
 void render_show_pause(void) {
-    // Lines (<=40 chars, uppercase)
-    static const char L1[] = "== PAUSED ==";                 // length 12
-    static const char L2[] = "PRESS SPACE TO CONTINUE";      // length 24
-
     // Light blue border while paused (optional)
-    VICII->BORDER_COLOR = 14u;
+    HAL_BORDER = 14u;
+
+    // Direct overlay: land queued updates first, then keep what it covers
+    render_flush();
+    render_save_image(g_pause_scr, g_pause_col);
 
-    // Draw centered, white
-    print_centered((unsigned char)12, L1, (unsigned char)1);
-    print_centered((unsigned char)13, L2, (unsigned char)1);
+    // "== PAUSED ==" and "PRESS SPACE TO CONTINUE", centered in white; the
+    // packed overlay leaves all other cells as they are
+    show_packed(SCR_PAUSE);
+    render_present();
 }
 
-// Erase the pause overlay (restores spaces over the same area)
+// Erase the pause overlay by restoring the playfield snapshot (one block copy)
 void render_hide_pause(void) {
-    // Must match the strings used in render_show_pause()
-    const unsigned char LEN1 = (unsigned char)12;  // "== PAUSED =="
-    const unsigned char LEN2 = (unsigned char)24;  // "PRESS SPACE TO CONTINUE"
-
-    clear_centered_line((unsigned char)12, LEN1);
-    clear_centered_line((unsigned char)13, LEN2);
+    render_flush();
+    render_copy_image(g_pause_scr, g_pause_col);
+    render_present();
 }
 
 // ---------------------------------------------
 // Title / Start screen
 // ---------------------------------------------
-// Show the start screen (safe for C64 UPPERCASE/GRAPHICS charset)
+// Show the start screen: blue playfield with the rules, in one unpack
 void render_show_start_screen(void) {
-    VICII->BORDER_COLOR = 14u;
-    VICII->BG_COLOR     = 6u;
-    render_clear_playfield();
-
-    print_centered(6,  "S N A K E",                       1);
-    print_centered(9,  "EAT FOOD TO GROW",                1);
-    print_centered(10, "EAT EVERY 12 SECONDS TO SURVIVE", 1);
-    print_centered(12, "DO NOT RUN INTO YOURSELF",        1);
-    print_centered(14, "MOVE WITH WASD  P FOR PAUSE",     1);
-    print_centered(17, "PRESS SPACE TO START",            7);
-}
-
-// ASCII (uppercase) -> C64 screen code-
-static unsigned char ascii_to_screen(unsigned char ch) {
-    // Map 'A'..'Z' (65..90) -> 1..26 using 8-bit subtraction + range check
-    // Other chars are mostly left as-is (space, digits, punctuation)
-    unsigned char t = (unsigned char)(ch - (unsigned char)65);
-    if (t <= (unsigned char)25) {
-        return (unsigned char)(t + (unsigned char)1);
-    }
-    // Space stays space
-    if (ch == (unsigned char)32) return (unsigned char)32;
-
-    // Digits and basic punctuation are fine as-is in screen codes
-    return ch;
+    HAL_BORDER = 14u;
+    HAL_BG     = 6u;
+    screen_forget();
+    show_packed(SCR_TITLE);
+    render_present();
 }
-
-// --- Centered print ---
-static void print_centered(unsigned char row, const char* s, unsigned char color) {
-    const unsigned char COLS = (unsigned char)40;
-    unsigned char len = 0;
-    const char* p = s;
-    unsigned char rem = COLS;
-
-    while ((*p != 0) && (rem != 0)) { ++len; ++p; --rem; }
-
-    // (40 - len) / 2  using 8-bit math
-    unsigned char col = (unsigned char)(((unsigned char)(COLS - len)) >> 1);
-
-    // write chars & color
-    {
-        unsigned int off = (unsigned int)row * 40u + (unsigned int)col;
-        unsigned char i = 0;
-        while (i != len) {
-            unsigned char sc = ascii_to_screen((unsigned char)s[i]);
-            SCREEN[off + i]    = sc;
-            COLOR_RAM[off + i] = color;
-            ++i;
-        }
-    }
-}
-
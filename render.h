@@ -5,14 +5,31 @@
 // Provides playfield addressing, colors/glyphs, and drawing/HUD routines.
 
 #include "snake.h"
+#include "hal.h"
 
 // Map dimensions for text mode
 #define MAP_W 40
 #define MAP_H 25
 
 // Simple text-mode renderer base addresses
-#define SCREEN      ((unsigned char*)0x0400)
-#define COLOR_RAM   ((unsigned char*)0xD800)
+#ifndef SCREEN_DOUBLE
+#define SCREEN      HAL_SCREEN
+#define SCREEN_SHOWN    HAL_SCREEN
+#define COLOR_RAM   HAL_COLOR_RAM
+#else
+// Double buffer (-DSCREEN_DOUBLE): direct drawing goes to the hidden screen
+// and to a colour image in RAM; render_present() shows them
+extern unsigned char* render_back;
+#define SCREEN      render_back
+// The screen the VIC-II shows: the one render_back is not
+#define SCREEN_SHOWN    ((render_back == HAL_SCREEN_B) ? HAL_SCREEN : HAL_SCREEN_B)
+#ifndef RENDER_ECM
+extern unsigned char render_back_color[MAP_W*MAP_H];
+#define COLOR_RAM   render_back_color
+#else
+#define COLOR_RAM   HAL_COLOR_RAM
+#endif
+#endif
 
 // Foreground color used for generic text (white)
 #define COL_FG_WHITE 1
@@ -24,7 +41,13 @@
 #define CH_EMPTY     ' '
 
 // Snake cell glyph (PETSCII/screencode)
+#ifndef RENDER_ECM
 #define CH_SNAKE     0xA0
+#else
+// ECM mode (-DRENDER_ECM): cells carry their colour in the screen code (a
+// space on background colour 1..3); colour RAM stays white for the text
+#define CH_SNAKE     0x60
+#endif
 
 // Clear entire screen to background + white foreground text
 void render_clear(void);
@@ -36,40 +59,116 @@ void clear_battlefield();
 void render_draw_snake_full(const Snake* s);
 
 // Apply one movement step: erase tail cell and draw head cell
-void render_apply_step(unsigned char tail_x, unsigned char tail_y,
-                       unsigned char head_x, unsigned char head_y);
+// (cells are screen offsets, see snake.h)
+void render_apply_step(Cell tail, Cell head);
 
-// Draw the HUD time at a fixed position (0,0) as mm:ss
-void render_draw_time(unsigned int total_seconds);
+// Draw the HUD clock at (0,0) from a packed-BCD clock (see game_clock()):
+// "MM:SS", or "MMMM:SS" from 100 minutes on. Only digits that changed since
+// the last call are written; a screen clear makes the next call redraw all
+void render_draw_clock(const unsigned char* clock);
 
-// Draw the HUD time at (x,y) as mm:ss without division/modulo
-void render_draw_mmss_at(unsigned char x, unsigned char y, unsigned int total_seconds);
-
-// Draw the Game Over screen with elapsed time and restart hint
-void render_game_over(unsigned int total_seconds);
+// Draw the Game Over screen with the BCD game clock and restart hint
+// won != 0 shows the board-full win title instead (green border)
+void render_game_over(const unsigned char* clock, unsigned char won);
 
 // Food color (C64 YELLOW). Kept consistent with the rest of the palette.
 #define COL_FOOD     7
 
 // Food glyph (distinct PETSCII/screencode)
+#ifndef RENDER_ECM
 #define CH_FOOD      0x51
+#else
+#define CH_FOOD      0xA0
+#endif
 
-// Draw a food glyph at (x,y)
-void render_draw_food(unsigned char x, unsigned char y);
+// Bonus food: diamond glyph in cyan (ECM: a cyan cell)
+#ifndef RENDER_ECM
+#define CH_FOOD_BONUS   0x5A
+#else
+#define CH_FOOD_BONUS   0xE0
+#endif
+#define COL_FOOD_BONUS  3
+
+// Draw the glyph of food 'type' (FOOD_PLAIN / FOOD_BONUS) at cell c
+void render_draw_food(Cell c, unsigned char type);
+
+#ifdef SPRITE_HEAD
+// Sprite head (-DSPRITE_HEAD): place sprite 0 over head cell (x,y), moved
+// 'frac'/256 of a cell toward the next cell in 'dir'. Call once per frame; the
+// VIC-II registers are written by the next render_flush()
+void render_head_sprite(unsigned char x, unsigned char y, Direction dir, unsigned char frac);
+
+// Switch the head sprite off (clears do this too)
+void render_head_sprite_hide(void);
+#endif
 
 // Draw only the new snake head (used when growing; no tail erase)
-void render_apply_grow(unsigned char head_x, unsigned char head_y);
+void render_apply_grow(Cell head);
 
 // Clear the whole playfield area to the background char/color
 void render_clear_playfield(void);
 
 // Replace a single cell with the playfield background
-void render_erase_cell(unsigned char x, unsigned char y);
+void render_erase_cell(Cell c);
 
 // Show or hide the "PAUSED" message at fixed position (16,12)
+// Show snapshots the screen; hide restores it, so nothing needs redrawing
 void render_show_pause(void);
 void render_hide_pause(void);
 
+/* ------------------------------------------------------------
+   Block primitives (four 250-byte runs, 8-bit index)
+------------------------------------------------------------ */
+// Fill all 1000 screen cells with one character
+void render_fill_screen(unsigned char ch);
+
+// Fill all 1000 colour RAM cells with one colour
+void render_fill_color(unsigned char col);
+
+// Copy a prebuilt 1000-byte screen image and colour image to the screen
+void render_copy_image(const unsigned char* scr, const unsigned char* col);
+
+// Save the current screen and colour RAM into 1000-byte buffers
+void render_save_image(unsigned char* scr, unsigned char* col);
+
 void render_show_start_screen(void);
 
+/* ------------------------------------------------------------
+   Deferred cell updates
+   render_apply_step/grow, render_draw_food, render_draw_clock and
+   render_erase_cell only queue their writes. render_flush() writes the
+   queue to SCREEN/COLOR_RAM; call it once per frame in the lower border
+   (frame_sync_and_input() does). Full redraws flush first; clears drop it.
+------------------------------------------------------------ */
+void render_flush(void);
+
+/* ------------------------------------------------------------
+   Page flipping (-DSCREEN_DOUBLE)
+   Full redraws (clears, render_draw_snake_full, the packed screens, the
+   pause overlay) draw into the hidden screen, so they may take any number
+   of frames without showing half-drawn. render_present() then waits for
+   the lower border, flips the VIC-II to that screen, writes the colours
+   ahead of the beam and brings the other screen up to date. Queued cell
+   updates are written to both screens. The screen functions below present
+   on their own; after render_draw_snake_full() the caller presents.
+   Without -DSCREEN_DOUBLE everything is drawn in place and this is a no-op.
+------------------------------------------------------------ */
+#ifdef SCREEN_DOUBLE
+void render_present(void);
+#else
+#define render_present()
+#endif
+
+// Longest flush so far in raster lines, and deepest queue seen
+void render_flush_stats(unsigned char* out_lines_max, unsigned char* out_peak);
+
+// Draw the flush stats as "Fnn Qnn" at the top-right of the HUD row
+void render_draw_flush_stats(void);
+
+// Draw a two-digit HUD stat "Tnn" (tag letter + value, capped at 99) at (x,0)
+void render_draw_stat(unsigned char x, unsigned char tag, unsigned char value);
+
+// Draw a five-digit HUD stat "Tnnnnn" (tag letter + 16-bit value) at (x,0)
+void render_draw_stat5(unsigned char x, unsigned char tag, unsigned int value);
+
 #endif
@@ -0,0 +1,117 @@
+// replay.c
+// Run-length turn log for deterministic replays (see replay.h)
+
+#include "hal.h"
+#include "replay.h"
+
+#ifdef REPLAY
+
+#ifdef HAL_HOST
+unsigned char replay_buf[REPLAY_SIZE];
+#endif
+
+// Next free (record) or next unread (play) buffer position
+static uint16_t g_pos;
+
+#ifdef REPLAY_RECORD
+/* ------------------------------------------------------------
+   Record
+------------------------------------------------------------ */
+
+// Direction of the previous move, straight moves since the last event
+static Direction g_last_dir;
+static unsigned char g_run;
+
+// Append one event; the end marker always follows the last event
+static void put(unsigned char ev) {
+    unsigned char* b = REPLAY_BUF;
+    // Full: keep what fits (the log stays terminated)
+    if (g_pos >= (uint16_t)(REPLAY_SIZE - 1u)) return;
+    b[g_pos] = ev;
+    g_pos++;
+    b[g_pos] = REPLAY_END;
+}
+
+uint16_t replay_begin(void) {
+    unsigned char* b = REPLAY_BUF;
+
+    // Fresh seed from the hardware RNG
+    hal_rnd_init();
+    uint16_t seed = hal_rnd();
+    seed = (seed << 8) | hal_rnd();
+
+    b[0] = 'R';
+    b[1] = 'P';
+    b[2] = (unsigned char)seed;
+    b[3] = (unsigned char)(seed >> 8);
+    b[REPLAY_HDR] = REPLAY_END;
+    g_pos = REPLAY_HDR;
+
+    // The snake starts moving right (game_loop)
+    g_last_dir = DIR_RIGHT;
+    g_run = 0u;
+    return seed;
+}
+
+void replay_move(Direction* dir) {
+    Direction d = *dir;
+    if (d != g_last_dir) {
+        put((unsigned char)(((unsigned char)d << 6) | g_run));
+        g_last_dir = d;
+        g_run = 0u;
+        return;
+    }
+    if (++g_run == REPLAY_SKIP) {
+        put(REPLAY_SKIP);
+        g_run = 0u;
+    }
+}
+
+#else
+/* ------------------------------------------------------------
+   Play
+------------------------------------------------------------ */
+
+// Pending event, and straight moves left before it applies
+static unsigned char g_ev;
+static unsigned char g_left;
+
+// Fetch the next event (stays on REPLAY_END)
+static void next_event(void) {
+    unsigned char* b = REPLAY_BUF;
+    g_ev = b[g_pos];
+    if (g_ev != REPLAY_END) g_pos++;
+    g_left = g_ev & 0x3Fu;
+}
+
+uint16_t replay_begin(void) {
+    unsigned char* b = REPLAY_BUF;
+    g_pos = REPLAY_HDR;
+
+    // No recording loaded: play nothing
+    if (b[0] != 'R' || b[1] != 'P') {
+        g_ev = REPLAY_END;
+        return 1u;
+    }
+    next_event();
+    return (uint16_t)b[2] | ((uint16_t)b[3] << 8);
+}
+
+void replay_move(Direction* dir) {
+    if (g_ev == REPLAY_END) return;
+
+    // A straight move
+    if (g_left != 0u) {
+        g_left--;
+        if (g_left == 0u && g_ev == REPLAY_SKIP) next_event();
+        return;
+    }
+
+    // The turn move
+    *dir = (Direction)(g_ev >> 6);
+    next_event();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// replay.h
+// Deterministic input replay (build with -DREPLAY_RECORD or -DREPLAY_PLAY).
+// - Record: every direction the snake takes is logged per move, together
+//   with the food RNG seed of the game, into a run-length buffer
+// - Play: the same buffer drives the direction instead of the keyboard, so
+//   the game repeats move for move (same turns, same food)
+// The buffer holds the current/last game. Pause is disabled in both modes so
+// moves and seconds keep the same phase (exact with the default polling
+// frame engine).
+
+#include <stdint.h>
+#include "snake.h"
+
+#if defined(REPLAY_RECORD) || defined(REPLAY_PLAY)
+#define REPLAY 1
+#endif
+
+// Buffer size in bytes (4-byte header + 1 byte per turn or per 63 straight moves)
+#ifndef REPLAY_SIZE
+#define REPLAY_SIZE 2048u
+#endif
+
+// Buffer location: $C800-$CFFF on the C64 (dump or load it with the VICE
+// monitor), a plain array on the host
+#ifdef HAL_HOST
+extern unsigned char replay_buf[REPLAY_SIZE];
+#define REPLAY_BUF (replay_buf)
+#else
+#define REPLAY_BUF ((unsigned char*)0xC800)
+#endif
+
+// Buffer layout
+// +0  'R' 'P'
+// +2  food RNG seed (16-bit, little endian)
+// +4  events, then REPLAY_END:
+//     (dir << 6) | n  the move after n straight moves turns to dir (n < 63)
+//     REPLAY_SKIP     63 straight moves
+#define REPLAY_HDR   4u
+#define REPLAY_SKIP  0x3Fu
+#define REPLAY_END   0xFFu
+
+// Start of a game: returns the food RNG seed to use.
+// Record: draws a fresh seed and starts a new log with it.
+// Play: rewinds the buffer and returns its seed (1 if the buffer is empty).
+uint16_t replay_begin(void);
+
+// Once per move, with the direction the move is about to use.
+// Record: logs *dir. Play: replaces *dir from the log.
+void replay_move(Direction* dir);
+
+#endif
@@ -0,0 +1,57 @@
+// screens.c
+// Packed screens, generated by tools/mkscreens.c from assets/*.txt.
+// Do not edit: change the layouts and run make -C host screens.
+
+#include "screens.h"
+
+const unsigned char SCR_TITLE[190] = {
+    0xff, 0x20, 0xff, 0x20, 0x0a, 0x20, 0x13, 0x20, 0x0e, 0x20, 0x01, 0x20,
+    0x0b, 0x20, 0x05, 0xec, 0x20, 0x10, 0x05, 0x01, 0x14, 0x20, 0x06, 0x0f,
+    0x0f, 0x04, 0x20, 0x14, 0x0f, 0x20, 0x07, 0x12, 0x0f, 0x17, 0x90, 0x20,
+    0x1f, 0x05, 0x01, 0x14, 0x20, 0x05, 0x16, 0x05, 0x12, 0x19, 0x20, 0x31,
+    0x32, 0x20, 0x13, 0x05, 0x03, 0x0f, 0x0e, 0x04, 0x13, 0x20, 0x14, 0x0f,
+    0x20, 0x13, 0x15, 0x12, 0x16, 0x09, 0x16, 0x05, 0xb5, 0x20, 0x18, 0x04,
+    0x0f, 0x20, 0x0e, 0x0f, 0x14, 0x20, 0x12, 0x15, 0x0e, 0x20, 0x09, 0x0e,
+    0x14, 0x0f, 0x20, 0x19, 0x0f, 0x15, 0x12, 0x13, 0x05, 0x0c, 0x06, 0xb6,
+    0x20, 0x1b, 0x0d, 0x0f, 0x16, 0x05, 0x20, 0x17, 0x09, 0x14, 0x08, 0x20,
+    0x17, 0x01, 0x13, 0x04, 0x20, 0x20, 0x10, 0x20, 0x06, 0x0f, 0x12, 0x20,
+    0x10, 0x01, 0x15, 0x13, 0x05, 0xe1, 0x20, 0x14, 0x10, 0x12, 0x05, 0x13,
+    0x13, 0x20, 0x13, 0x10, 0x01, 0x03, 0x05, 0x20, 0x14, 0x0f, 0x20, 0x13,
+    0x14, 0x01, 0x12, 0x14, 0xff, 0x20, 0xff, 0x20, 0xa4, 0x20, 0x00,
+    0xff, 0x06, 0xff, 0x06, 0x01, 0x06, 0x89, 0x01, 0xec, 0x06, 0x90, 0x01,
+    0x90, 0x06, 0x9f, 0x01, 0xb5, 0x06, 0x98, 0x01, 0xb6, 0x06, 0x9b, 0x01,
+    0xe1, 0x06, 0x94, 0x07, 0xff, 0x06, 0xff, 0x06, 0xa4, 0x06, 0x00,
+};
+
+const unsigned char SCR_OVER[89] = {
+    0xff, 0x20, 0xff, 0x20, 0xff, 0x20, 0x9e, 0x20, 0x07, 0x07, 0x20, 0x01,
+    0x20, 0x0d, 0x20, 0x05, 0x83, 0x20, 0x07, 0x0f, 0x20, 0x16, 0x20, 0x05,
+    0x20, 0x12, 0xeb, 0x20, 0x04, 0x14, 0x09, 0x0d, 0x05, 0xff, 0x20, 0xbc,
+    0x20, 0x1b, 0x10, 0x12, 0x05, 0x13, 0x13, 0x20, 0x13, 0x10, 0x01, 0x03,
+    0x05, 0x20, 0x0f, 0x12, 0x20, 0x12, 0x20, 0x14, 0x0f, 0x20, 0x12, 0x05,
+    0x13, 0x14, 0x01, 0x12, 0x14, 0xff, 0x20, 0xf8, 0x20, 0x00,
+    0xff, 0x01, 0xff, 0x01, 0xff, 0x01, 0xff, 0x01, 0xff, 0x01, 0xdb, 0x01,
+    0x9b, 0x07, 0xff, 0x01, 0xf8, 0x01, 0x00,
+};
+
+const unsigned char SCR_WON[111] = {
+    0xff, 0x20, 0xff, 0x20, 0xff, 0x20, 0x93, 0x20, 0x09, 0x02, 0x20, 0x0f,
+    0x20, 0x01, 0x20, 0x12, 0x20, 0x04, 0x83, 0x20, 0x07, 0x06, 0x20, 0x15,
+    0x20, 0x0c, 0x20, 0x0c, 0x83, 0x20, 0x01, 0x2d, 0x83, 0x20, 0x05, 0x19,
+    0x20, 0x0f, 0x20, 0x15, 0x83, 0x20, 0x05, 0x17, 0x20, 0x09, 0x20, 0x0e,
+    0xe0, 0x20, 0x04, 0x14, 0x09, 0x0d, 0x05, 0xff, 0x20, 0xbc, 0x20, 0x1b,
+    0x10, 0x12, 0x05, 0x13, 0x13, 0x20, 0x13, 0x10, 0x01, 0x03, 0x05, 0x20,
+    0x0f, 0x12, 0x20, 0x12, 0x20, 0x14, 0x0f, 0x20, 0x12, 0x05, 0x13, 0x14,
+    0x01, 0x12, 0x14, 0xff, 0x20, 0xf8, 0x20, 0x00,
+    0xff, 0x01, 0xff, 0x01, 0xff, 0x01, 0xff, 0x01, 0xff, 0x01, 0xdb, 0x01,
+    0x9b, 0x07, 0xff, 0x01, 0xf8, 0x01, 0x00,
+};
+
+const unsigned char SCR_PAUSE[63] = {
+    0x80, 0xff, 0x80, 0xef, 0x0c, 0x3d, 0x3d, 0x20, 0x10, 0x01, 0x15, 0x13,
+    0x05, 0x04, 0x20, 0x3d, 0x3d, 0x80, 0x16, 0x17, 0x10, 0x12, 0x05, 0x13,
+    0x13, 0x20, 0x13, 0x10, 0x01, 0x03, 0x05, 0x20, 0x14, 0x0f, 0x20, 0x03,
+    0x0f, 0x0e, 0x14, 0x09, 0x0e, 0x15, 0x05, 0x80, 0xff, 0x80, 0xc2, 0x00,
+    0x80, 0xff, 0x80, 0xef, 0x8c, 0x01, 0x80, 0x16, 0x97, 0x01, 0x80, 0xff,
+    0x80, 0xc2, 0x00,
+};
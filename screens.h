@@ -0,0 +1,21 @@
+#ifndef SCREENS_H
+#define SCREENS_H
+
+// screens.h
+// Packed screens, generated by tools/mkscreens.c from assets/*.txt.
+// Do not edit: change the layouts and run make -C host screens.
+// Each is a screen-code stream then a colour stream (format in mkscreens.c)
+
+// assets/title.txt: 155 + 35 bytes
+extern const unsigned char SCR_TITLE[190];
+
+// assets/over.txt: 70 + 19 bytes
+extern const unsigned char SCR_OVER[89];
+
+// assets/won.txt: 92 + 19 bytes
+extern const unsigned char SCR_WON[111];
+
+// assets/pause.txt: 48 + 15 bytes
+extern const unsigned char SCR_PAUSE[63];
+
+#endif
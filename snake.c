@@ -2,73 +2,283 @@
 
 // For MAP_W / MAP_H
 #include "render.h"
+// For hud_covers_cell() (HUD cells are never offered as free)
+#include "hud.h"
 #include <string.h>
 #include <stdint.h>
 
 /* ------------------------------------------------------------
-   Internal: wrap helpers for 0..(lim-1)  (d is -1, 0, or +1)
+   Per-direction wrap tables
+   A step in one direction only looks at one coordinate: the head row for
+   UP/DOWN, the head column for LEFT/RIGHT. For that coordinate the tables
+   give the next coordinate and the cell (offset) delta, both with the
+   wrap-around at the board edge folded in, so a move has no edge branches.
+   Deltas are mod 2^16 (0xFFFF = -1).
 ------------------------------------------------------------ */
+static uint8_t  g_wrap_up_y[MAP_H];
+static uint16_t g_wrap_up_d[MAP_H];
+static uint8_t  g_wrap_down_y[MAP_H];
+static uint16_t g_wrap_down_d[MAP_H];
+static uint8_t  g_wrap_left_x[MAP_W];
+static uint16_t g_wrap_left_d[MAP_W];
+static uint8_t  g_wrap_right_x[MAP_W];
+static uint16_t g_wrap_right_d[MAP_W];
+
+// Tracks whether the wrap tables have been built (0 = no, 1 = yes)
+static unsigned char g_wrap_inited = 0;
+
+// Build the wrap tables once (first snake_init_at)
+static void wrap_init(void) {
+    uint8_t i;
+    for (i = 0; i < (uint8_t)MAP_H; ++i) {
+        g_wrap_up_y[i]   = (uint8_t)(i - 1u);
+        g_wrap_up_d[i]   = (uint16_t)0u - MAP_W;
+        g_wrap_down_y[i] = (uint8_t)(i + 1u);
+        g_wrap_down_d[i] = MAP_W;
+    }
+    g_wrap_up_y[0] = (uint8_t)(MAP_H - 1);
+    g_wrap_up_d[0] = (uint16_t)(MAP_H - 1) * MAP_W;
+    g_wrap_down_y[MAP_H - 1] = 0;
+    g_wrap_down_d[MAP_H - 1] = (uint16_t)0u - (uint16_t)(MAP_H - 1) * MAP_W;
+
+    for (i = 0; i < (uint8_t)MAP_W; ++i) {
+        g_wrap_left_x[i]  = (uint8_t)(i - 1u);
+        g_wrap_left_d[i]  = 0xFFFFu;
+        g_wrap_right_x[i] = (uint8_t)(i + 1u);
+        g_wrap_right_d[i] = 1u;
+    }
+    g_wrap_left_x[0] = (uint8_t)(MAP_W - 1);
+    g_wrap_left_d[0] = (uint16_t)(MAP_W - 1);
+    g_wrap_right_x[MAP_W - 1] = 0;
+    g_wrap_right_d[MAP_W - 1] = (uint16_t)0u - (uint16_t)(MAP_W - 1);
+
+    g_wrap_inited = 1;
+}
+
+// Move cell c at column/row (*x,*y) one step in 'dir'; updates *x and *y
+static Cell cell_step(Cell c, Direction dir, uint8_t* x, uint8_t* y) {
+    if (dir == DIR_UP) {
+        c += g_wrap_up_d[*y];
+        *y = g_wrap_up_y[*y];
+    } else if (dir == DIR_DOWN) {
+        c += g_wrap_down_d[*y];
+        *y = g_wrap_down_y[*y];
+    } else if (dir == DIR_LEFT) {
+        c += g_wrap_left_d[*x];
+        *x = g_wrap_left_x[*x];
+    } else {
+        c += g_wrap_right_d[*x];
+        *x = g_wrap_right_x[*x];
+    }
+    return c;
+}
+
+// Next head cell for 'dir'; also writes the next head column/row
+static Cell next_head(const Snake* s, Direction dir, uint8_t* out_x, uint8_t* out_y) {
+    *out_x = s->hx;
+    *out_y = s->hy;
+    return cell_step(snake_head_cell(s), dir, out_x, out_y);
+}
+
+#ifdef SNAKE_PACKED
+/* ------------------------------------------------------------
+   Packed move ring (-DSNAKE_PACKED): 2-bit directions, four per byte.
+   Quarter q lives in bits (q*2 .. q*2+1); shifts are by constants only.
+------------------------------------------------------------ */
+
+// Keep masks that clear the bit pair of quarter q (no '~')
+static const uint8_t QKEEP[4] = { 0xFC, 0xF3, 0xCF, 0x3F };
+
+// Direction stored at (b, q)
+static inline uint8_t mv_get(const Snake* s, uint8_t b, uint8_t q) {
+    uint8_t v = s->mv[b];
+    if (q & 2) v = v >> 4;
+    if (q & 1) v = v >> 2;
+    return (uint8_t)(v & 3);
+}
+
+// Store direction d at (b, q)
+static inline void mv_put(Snake* s, uint8_t b, uint8_t q, uint8_t d) {
+    if (q & 1) d = d << 2;
+    if (q & 2) d = d << 4;
+    s->mv[b] = (s->mv[b] & QKEEP[q]) | d;
+}
+
+// Start a walk at the tail
+void snake_walk_begin(const Snake* s, SnakeWalk* w) {
+    w->b = s->tail_b;
+    w->q = s->tail_q;
+    w->x = s->tx;
+    w->y = s->ty;
+    w->c = s->tail_cell;
+}
 
-// Add -1/0/+1 to v with wrap-around in [0..lim-1]
-static uint8_t wrap_add(uint8_t v, int8_t d, uint8_t lim) {
-    if (d > 0) {
-        if (++v >= lim) v = 0;
-    } else if (d < 0) {
-        if (v == 0) v = (uint8_t)(lim - 1);
-        else --v;
+// Return the current cell and follow its stored move toward the head
+// (at the head this reads the unused slot after the last move: harmless)
+Cell snake_walk_next(const Snake* s, SnakeWalk* w) {
+    Cell c = w->c;
+    uint8_t x = w->x;
+    uint8_t y = w->y;
+    w->c = cell_step(c, (Direction)mv_get(s, w->b, w->q), &x, &y);
+    w->x = x;
+    w->y = y;
+    if (++w->q == 4) {
+        w->q = 0;
+        w->b++;
     }
-    return v;
+    return c;
 }
+#endif
 
 /* ------------------------------------------------------------
-   Optional occupancy grid (bitset W*H)
+   Optional occupancy grid (bitset W*H, bit index = cell)
    NOTE: Avoid '~' operator (KickC 0.8.6 fragment gap) by using tables.
 ------------------------------------------------------------ */
 #define OCC_W   (MAP_W)
 #define OCC_H   (MAP_H)
 #define OCC_SZ  ((OCC_W*OCC_H + 7u)/8u)
 
-static uint8_t g_occ[OCC_SZ];
+static HAL_ALIGN(0x100) uint8_t g_occ[OCC_SZ];
 
 /* Bit tables for set/clear/test without '~' */
-static const uint8_t BIT[8]   = { 0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80 };
-static const uint8_t NBIT[8]  = { 0xFE,0xFD,0xFB,0xF7,0xEF,0xDF,0xBF,0x7F };
+static HAL_ALIGN(0x10) const uint8_t BIT[8]   = { 0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80 };
+static HAL_ALIGN(0x10) const uint8_t NBIT[8]  = { 0xFE,0xFD,0xFB,0xF7,0xEF,0xDF,0xBF,0x7F };
 
-// Compute linear bit index into occupancy grid for (x,y)
-static inline uint16_t occ_idx(uint8_t x, uint8_t y) { return (uint16_t)y * OCC_W + x; }
+/* ------------------------------------------------------------
+   Free-cell pool (swap-remove), kept in sync with the bitset.
+   - g_free_cell[0..g_free_n-1] : every free, non-reserved cell
+   - g_free_pos[c]              : slot of cell c in the pool,
+                                  or FREE_OUT (occupied) / FREE_RESERVED (HUD)
+   Take/give are O(1), so a food spawn is a single indexed pick.
+------------------------------------------------------------ */
+#define OCC_CELLS      (OCC_W*OCC_H)
+#define FREE_OUT       0xFFFEu
+#define FREE_RESERVED  0xFFFFu
+
+static HAL_ALIGN(0x100) uint16_t g_free_cell[OCC_CELLS];
+static HAL_ALIGN(0x100) uint16_t g_free_pos[OCC_CELLS];
+static HAL_ZP uint16_t g_free_n;
+
+// Remove cell c from the pool (no-op if already out or reserved)
+static void pool_take(Cell c) {
+    uint16_t p = g_free_pos[c];
+    if (p >= FREE_OUT) return;
+
+    // Move the last pool entry into the vacated slot
+    g_free_n = g_free_n - 1u;
+    Cell last = g_free_cell[g_free_n];
+    g_free_cell[p] = last;
+    g_free_pos[last] = p;
+    g_free_pos[c] = FREE_OUT;
+}
+
+// Return cell c to the pool (no-op if already in or reserved)
+static void pool_give(Cell c) {
+    if (g_free_pos[c] != FREE_OUT) return;
+    g_free_cell[g_free_n] = c;
+    g_free_pos[c] = g_free_n;
+    g_free_n++;
+}
 
 // Mark a cell as occupied in the bitset using precalculated bit masks
-static inline void     occ_set(uint16_t i)  { uint8_t b = (uint8_t)(i & 7); g_occ[i >> 3] |=  BIT[b]; }
+static inline void     occ_set(Cell c)  { uint8_t b = (uint8_t)(c & 7); g_occ[c >> 3] |=  BIT[b]; pool_take(c); }
 
 // Clear a cell from the bitset using precalculated inverse masks
-static inline void     occ_clr(uint16_t i)  { uint8_t b = (uint8_t)(i & 7); g_occ[i >> 3] &= NBIT[b]; }
+static inline void     occ_clr(Cell c)  { uint8_t b = (uint8_t)(c & 7); g_occ[c >> 3] &= NBIT[b]; pool_give(c); }
 
 // Test whether a cell is occupied (returns non-zero if set)
-static inline uint8_t  occ_get(uint16_t i)  { uint8_t b = (uint8_t)(i & 7); return (uint8_t)(g_occ[i >> 3] & BIT[b]); }
+static inline uint8_t  occ_get(Cell c)  { uint8_t b = (uint8_t)(c & 7); return (uint8_t)(g_occ[c >> 3] & BIT[b]); }
 
 /* Public wrappers: rebuild occupancy from snake body */
 
-// Rebuild the occupancy grid from the current snake body
+// Rebuild the occupancy grid and free-cell pool from the current snake body
+// (one pass over the board, then walks tail..head)
 void snake_occ_reset_from_body(const Snake* s) {
     memset(g_occ, 0, sizeof(g_occ));
-    for (uint8_t i = 0; i < s->len; ++i) {
-        occ_set(occ_idx(s->x[i], s->y[i]));
+
+    // Every cell starts free, except the ones the HUD draws over
+    g_free_n = 0;
+    Cell c = 0;
+    for (uint8_t y = 0; y < (uint8_t)OCC_H; ++y) {
+        for (uint8_t x = 0; x < (uint8_t)OCC_W; ++x) {
+            if (hud_covers_cell(x, y)) {
+                g_free_pos[c] = FREE_RESERVED;
+            } else {
+                g_free_pos[c] = FREE_OUT;
+                pool_give(c);
+            }
+            c++;
+        }
+    }
+
+    SnakeWalk w;
+    snake_walk_begin(s, &w);
+    for (uint16_t n = s->len; n != 0; n = n - 1u) {
+        occ_set(snake_walk_next(s, &w));
     }
 }
 
-// Check if coordinate (x,y) is occupied by the snake (non-zero if yes)
-uint8_t snake_occ_test(uint8_t x, uint8_t y) { return occ_get(occ_idx(x, y)); }
+// Check if cell c is occupied by the snake (non-zero if yes)
+uint8_t snake_occ_test(Cell c) { return occ_get(c); }
+
+// Mark cell c as occupied
+void    snake_occ_set (Cell c) { occ_set(c); }
+
+// Mark cell c as free
+void    snake_occ_clear(Cell c) { occ_clr(c); }
 
-// Mark coordinate (x,y) as occupied
-void    snake_occ_set (uint8_t x, uint8_t y) { occ_set(occ_idx(x, y)); }
+// Number of free (unoccupied, non-HUD) cells
+uint16_t snake_free_count(void) { return g_free_n; }
 
-// Mark coordinate (x,y) as free
-void    snake_occ_clear(uint8_t x, uint8_t y) { occ_clr(occ_idx(x, y)); }
+// Free-pool entry k (k < snake_free_count())
+Cell snake_free_cell(uint16_t k) {
+    return g_free_cell[k];
+}
+
+// Reserve / release a free cell for an item (occupancy bit untouched)
+void snake_free_take(Cell c) { pool_take(c); }
+void snake_free_give(Cell c) { pool_give(c); }
 
 /* ------------------------------------------------------------
    Core API
 ------------------------------------------------------------ */
 
+// Initialize a one-segment snake at (x,y); seed occupancy grid
+void snake_init_at(Snake* s, uint8_t x, uint8_t y) {
+    Cell c = (Cell)y * MAP_W + x;
+
+    if (!g_wrap_inited) wrap_init();
+
+    s->len = 1;
+#ifdef SNAKE_PACKED
+    // No moves stored yet: head and tail slots coincide
+    s->head_b    = 0;
+    s->head_q    = 0;
+    s->tail_b    = 0;
+    s->tail_q    = 0;
+    s->head_cell = c;
+    s->tail_cell = c;
+    s->tx        = x;
+    s->ty        = y;
+#else
+    // Head and tail share slot 0 of page 0
+    s->head    = 0;
+    s->head_pg = 0;
+    s->tail    = 0;
+    s->tail_pg = 0;
+    s->head_lo = s->lo;
+    s->head_hi = s->hi;
+    s->tail_lo = s->lo;
+    s->tail_hi = s->hi;
+    s->lo[0]   = (uint8_t)c;
+    s->hi[0]   = (uint8_t)(c >> 8);
+#endif
+    s->hx = x;
+    s->hy = y;
+
+    snake_occ_reset_from_body(s);
+}
+
 // Initialize snake as a centered horizontal line pointing right; seed occupancy grid
 void snake_init(Snake* s) {
     // Initial length and centered position
@@ -76,138 +286,143 @@ void snake_init(Snake* s) {
     const uint8_t cy = (uint8_t)(MAP_H / 2);
     const uint8_t cx = (uint8_t)(MAP_W / 2 - (start_len / 2));
 
-    // Set length and head index
-    s->len  = start_len;
-    s->head = (uint8_t)(start_len - 1);
-
-    // Fill contiguous body: indices 0..len-1 == tail..head
-    for (uint8_t i = 0; i < start_len; ++i) {
-        s->x[i] = (uint8_t)(cx + i);
-        s->y[i] = cy;
+    // Tail first, then grow the body to the right up to the head
+    snake_init_at(s, cx, cy);
+    for (uint8_t i = 1; i < start_len; ++i) {
+        snake_step_grow(s, DIR_RIGHT);
     }
-
-    // seed occupancy from the active body
-    snake_occ_reset_from_body(s);
 }
 
 // Write head (x,y) into out parameters without modifying the snake
 void snake_head_xy(const Snake* s, uint8_t* out_x, uint8_t* out_y) {
-    uint8_t h = (s->len > 0) ? (uint8_t)(s->len - 1) : 0;
-    *out_x = s->x[h];
-    *out_y = s->y[h];
+    *out_x = s->hx;
+    *out_y = s->hy;
 }
 
-// Compute the next wrapped head cell if moving one step in 'dir' (no mutation)
-void snake_next_xy(const Snake* s, Direction dir, uint8_t* out_x, uint8_t* out_y) {
-    uint8_t hx, hy;
-    snake_head_xy(s, &hx, &hy);
-
-    // Direction delta
-    int8_t dx = 0, dy = 0;
-    if (dir == DIR_UP)        dy = -1;
-    else if (dir == DIR_DOWN) dy = +1;
-    else if (dir == DIR_LEFT) dx = -1;
-    else                      dx = +1;
-
-    // Next head with wrapping
-    *out_x = wrap_add(hx, dx, MAP_W);
-    *out_y = wrap_add(hy, dy, MAP_H);
+// Cell the head would enter moving one step in 'dir' (no mutation)
+Cell snake_next_cell(const Snake* s, Direction dir) {
+    uint8_t nx, ny;
+    return next_head(s, dir, &nx, &ny);
 }
 
-// Advance one step in 'dir' with wrap-around; returns the tail cell that was removed
-void snake_step(Snake* s, Direction dir,
-                uint8_t* out_tail_x, uint8_t* out_tail_y) {
+// Neighbour of any cell (public wrapper of cell_step)
+Cell snake_cell_step(Cell c, Direction dir, uint8_t* x, uint8_t* y) {
+    return cell_step(c, dir, x, y);
+}
 
-    uint8_t nx, ny;
-    snake_next_xy(s, dir, &nx, &ny);
+#ifdef SNAKE_PACKED
+// Push cell c (reached by 'dir') as the new head at (x,y)
+// Stores the move in the head slot, then advances the slot
+static inline void push_head(Snake* s, Cell c, uint8_t x, uint8_t y, Direction dir) {
+    uint8_t q = s->head_q;
+    mv_put(s, s->head_b, q, (uint8_t)dir);
+    if (++q == 4) {
+        q = 0;
+        s->head_b++;
+    }
+    s->head_q = q;
+    s->head_cell = c;
+    s->hx = x;
+    s->hy = y;
+}
 
-    *out_tail_x = s->x[0];
-    *out_tail_y = s->y[0];
+// Drop the tail segment and return its cell
+// The new tail is the old one moved along the oldest stored move
+static inline Cell pop_tail(Snake* s) {
+    Cell t = s->tail_cell;
+    uint8_t q = s->tail_q;
+    uint8_t x = s->tx;
+    uint8_t y = s->ty;
+    s->tail_cell = cell_step(t, (Direction)mv_get(s, s->tail_b, q), &x, &y);
+    s->tx = x;
+    s->ty = y;
+    if (++q == 4) {
+        q = 0;
+        s->tail_b++;
+    }
+    s->tail_q = q;
+    return t;
+}
+#else
+// Push cell c as the new head at (x,y) ('dir' is not stored in this layout)
+// 8-bit slot step; the page (and its cached bases) only changes when the
+// slot wraps to 0
+static inline void push_head(Snake* s, Cell c, uint8_t x, uint8_t y, Direction dir) {
+    HAL_UNUSED(dir);
+    uint8_t h = (uint8_t)(s->head + 1u);
+    if (h == 0) {
+        uint8_t pg = snake_page_next(s->head_pg);
+        s->head_pg = pg;
+        s->head_lo = s->lo + ((uint16_t)pg << 8);
+        s->head_hi = s->hi + ((uint16_t)pg << 8);
+    }
+    s->head_lo[h] = (uint8_t)c;
+    s->head_hi[h] = (uint8_t)(c >> 8);
+    s->head = h;
+    s->hx = x;
+    s->hy = y;
+}
 
-    // shift body: [1]->[0], ..., [len-1]->[len-2]
-    uint8_t len = s->len;
-    for (uint8_t i = 0; i + 1 < len; ++i) {
-        s->x[i] = s->x[i+1];
-        s->y[i] = s->y[i+1];
+// Drop the tail segment and return its cell
+static inline Cell pop_tail(Snake* s) {
+    Cell t = snake_tail_cell(s);
+    if (++s->tail == 0) {
+        uint8_t pg = snake_page_next(s->tail_pg);
+        s->tail_pg = pg;
+        s->tail_lo = s->lo + ((uint16_t)pg << 8);
+        s->tail_hi = s->hi + ((uint16_t)pg << 8);
     }
+    return t;
+}
+#endif
+
+// Advance one step in 'dir' with wrap-around; returns the tail cell that was removed
+// Constant time: only the head and tail ring positions move, no body bytes are copied
+// (the head is pushed first: a packed one-segment snake pops the move just stored)
+void snake_step(Snake* s, Direction dir, Cell* out_tail) {
+    uint8_t nx, ny;
+    Cell next = next_head(s, dir, &nx, &ny);
 
-    // write new head
-    s->x[len-1] = nx;
-    s->y[len-1] = ny;
-    s->head = (uint8_t)(len - 1);
+    push_head(s, next, nx, ny, dir);
+    Cell tail = pop_tail(s);
+    *out_tail = tail;
 
-    snake_occ_clear(*out_tail_x, *out_tail_y);
-    snake_occ_set(nx, ny);
+    occ_clr(tail);
+    occ_set(next);
 }
 
 // Advance one step in 'dir' and grow by one segment (tail is not removed)
 // Grow by one segment (no tail removal). If already at SNAKE_LEN, behave like a normal step.
 void snake_step_grow(Snake* s, Direction dir) {
-    uint8_t nx, ny;
-    snake_next_xy(s, dir, &nx, &ny);
-
-    // Still room? append at the first free slot (index == len)
-    if (s->len < (uint8_t)SNAKE_LEN) {
-        // Append new segment
-        uint8_t idx = s->len;
-        s->x[idx] = nx;
-        s->y[idx] = ny;
-        // Advance logical length and head
-        s->len = (uint8_t)(idx + 1);
-        s->head = (uint8_t)(s->len - 1);
+    // Still room? append at the slot after the head (tail stays put)
+    if (s->len < SNAKE_LEN) {
+        uint8_t nx, ny;
+        Cell next = next_head(s, dir, &nx, &ny);
+        // Append new segment and advance logical length and head
+        push_head(s, next, nx, ny, dir);
+        s->len = s->len + 1u;
         // Mark new head as occupied
-        snake_occ_set(nx, ny);
+        occ_set(next);
     } else {
         // At capacity: just do a normal step so gameplay continues
-        uint8_t tx, ty;
-        snake_step(s, dir, &tx, &ty);
+        Cell tail;
+        snake_step(s, dir, &tail);
     }
 }
 
-unsigned char snake_tail_index(const Snake* s) {
-    return 0u;
-}
-
-// Compute the next wrapped head cell if moving in 'dir' (no mutation)
-void snake_compute_next_head_wrap(const Snake* s, Direction dir,
-                                  unsigned char* nx, unsigned char* ny) {
-    unsigned char hx, hy;
-    signed char dx = 0, dy = 0;
-    snake_head_xy(s, &hx, &hy);
+// Test if moving onto cell 'next' would collide with the snake body
+// O(1): one occupancy bit test plus a tail compare, independent of snake length
+unsigned char snake_will_self_collide_next(const Snake* s, Cell next,
+                                           unsigned char growing) {
+    // Free cell: never a collision
+    if (!occ_get(next)) return 0u;
 
-    if (dir==DIR_UP) dy = -1;
-    else if (dir==DIR_DOWN) dy = +1;
-    else if (dir==DIR_LEFT) dx = -1;
-    else dx = +1;
-
-    // X wrap
-    *nx = hx;
-    if (dx > 0) { (*nx)++; if (*nx >= MAP_W) *nx = 0; }
-    else if (dx < 0) { if (*nx == 0) *nx = (unsigned char)(MAP_W-1); else (*nx)--; }
-
-    // Y wrap
-    *ny = hy;
-    if (dy > 0) { (*ny)++; if (*ny >= MAP_H) *ny = 0; }
-    else if (dy < 0) { if (*ny == 0) *ny = (unsigned char)(MAP_H-1); else (*ny)--; }
-}
-
-// Test if moving to (nx,ny) would collide with the snake body (excluding moving tail)
-unsigned char snake_will_self_collide_next(const Snake* s,
-                                           unsigned char nx, unsigned char ny) {
-    for (uint8_t i = 1; i < s->len; ++i) {
-        if (s->x[i] == nx && s->y[i] == ny) return 1u;
+    // Grow step keeps the tail in place (unless capped, which steps normally)
+    if (growing) {
+        if (s->len < SNAKE_LEN) return 1u;
     }
+
+    // Normal step: the tail cell is vacated by the same move
+    if (snake_tail_cell(s) != next) return 1u;
     return 0u;
 }
-
-
-// Return 1 if the snake currently occupies cell (x,y); otherwise return 0
-// Performs a simple linear scan over the snake coordinates
-static uint8_t snake_cell_occupied(const Snake* s, uint8_t x, uint8_t y) {
-    uint8_t i = 0;
-    uint8_t len = s->len;
-    for (i = 0; i < len; i++) {
-        if (s->x[i] == x && s->y[i] == y) return 1;
-    }
-    return 0;
-}
\ No newline at end of file
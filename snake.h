@@ -3,11 +3,16 @@
 
 #include <stddef.h>
 #include <stdint.h>
-
-// Length of the snake’s ring buffer (compile-time fixed).
-// If your project already defines SNAKE_LEN elsewhere, that wins.
+#include "hal.h"
+
+// Maximum snake length in segments (compile-time fixed; below SNAKE_RING, or
+// at most 1024 with SNAKE_PACKED: both are checked below).
+// The default is the whole 40x25 board. The game is won when no free cell is
+// left; the HUD cells are never free but the body may pass over them, so the
+// length at the win lies between 993 and 1000. If your project already
+// defines SNAKE_LEN elsewhere, that wins.
 #ifndef SNAKE_LEN
-#define SNAKE_LEN 255u
+#define SNAKE_LEN 1000u
 #endif
 
 // Movement directions
@@ -18,18 +23,160 @@ typedef enum {
     DIR_RIGHT
 } Direction;
 
-// Snake body as a ring buffer:
-// - x[i], y[i] : (screen) cell of segment i
-// - head      : index of the newest segment (head) inside 0..SNAKE_LEN-1
-// - len       : total segments in use (== SNAKE_LEN in this fixed-length version)
-// This build starts at full length; growth calls are capped at SNAKE_LEN.
+// Board cell as its screen offset y*MAP_W + x (0..999). The playfield is
+// the full 40-column screen, so the same value indexes the occupancy grid,
+// screen RAM and colour RAM with no conversion.
+typedef uint16_t Cell;
+
+#ifdef SNAKE_PACKED
+
+// Packed body (-DSNAKE_PACKED): only the moves between segments are stored,
+// as 2-bit directions, four per byte, in a 256-byte ring (1024 moves). The
+// head and tail cells are cached; the tail is walked forward along the stored
+// moves. A byte index wraps by 8-bit overflow; the quarter q (0..3) picks
+// the bit pair (q * 2).
+#define SNAKE_MOVES 256u
+
+// A step pushes the head move before it pops the tail one, so a body of
+// len segments briefly holds len moves: at most SNAKE_MOVES * 4
+#if SNAKE_LEN > SNAKE_MOVES*4u
+#error "SNAKE_LEN is larger than the packed move ring (1024)"
+#endif
+
+// Snake body as a ring of moves:
+// - mv[]              : packed directions; the move at (tail_b, tail_q) leads
+//                       from the tail segment to the next one, (head_b, head_q)
+//                       is the slot the next head move is written to
+// - len               : total segments in use (len - 1 moves are stored)
+// - head_cell, hx, hy : head cell and its column/row
+// - tail_cell, tx, ty : tail cell and its column/row
+// Growth calls are capped at SNAKE_LEN (at most 1024, see above).
+typedef struct {
+    uint8_t  mv[SNAKE_MOVES];
+    uint16_t len;
+    uint8_t  head_b;
+    uint8_t  head_q;
+    uint8_t  tail_b;
+    uint8_t  tail_q;
+    Cell     head_cell;
+    Cell     tail_cell;
+    uint8_t  hx;
+    uint8_t  hy;
+    uint8_t  tx;
+    uint8_t  ty;
+} Snake;
+
+// Cell of the head segment
+static inline Cell snake_head_cell(const Snake* s) { return s->head_cell; }
+
+// Cell of the tail segment
+static inline Cell snake_tail_cell(const Snake* s) { return s->tail_cell; }
+
+// Body walk from tail to head (see snake_walk_next)
+typedef struct {
+    uint8_t b;
+    uint8_t q;
+    uint8_t x;
+    uint8_t y;
+    Cell    c;
+} SnakeWalk;
+
+// Start a walk at the tail
+void snake_walk_begin(const Snake* s, SnakeWalk* w);
+
+// Return the current cell and step one segment toward the head
+// (call at most len times)
+Cell snake_walk_next(const Snake* s, SnakeWalk* w);
+
+#else
+
+// Paged ring buffer: SNAKE_PAGES pages of 256 slots per offset byte. A ring
+// position is (page, slot); stepping the slot is a plain 8-bit increment and
+// only its wrap to 0 (once per 256 moves) steps the page. Must be a power of 2.
+#define SNAKE_PAGES 4u
+#define SNAKE_RING  (SNAKE_PAGES * 256u)
+
+// A step pushes the head before it pops the tail, so at len == SNAKE_RING
+// the new head slot would be the live tail slot
+#if SNAKE_LEN >= SNAKE_RING
+#error "SNAKE_LEN must be below the ring size (1024)"
+#endif
+
+// Snake body as a ring buffer of cells:
+// - lo[k], hi[k]  : low/high byte of the cell (screen offset) at ring slot
+//                   k = page * 256 + slot
+// - head, head_pg : slot and page of the newest segment (head)
+// - tail, tail_pg : slot and page of the oldest segment (tail)
+// - head_lo/hi,
+//   tail_lo/hi    : lo[]/hi[] page of head_pg/tail_pg, moved only when that
+//                   page changes, so a move indexes with the 8-bit slot alone
+// - len           : total segments in use (tail..head, wrapping at SNAKE_RING)
+// - hx, hy        : head column/row, kept for the wrap tables and the sprite head
+// A move advances head and tail by one slot, so its cost does not depend on len.
+// Growth calls are capped at SNAKE_LEN.
+// The arrays come first: a Snake placed with HAL_ALIGN(0x100) has every page of
+// lo[] and hi[] on a page of its own.
 typedef struct {
-    uint8_t len;
-    uint8_t head;
-    uint8_t x[SNAKE_LEN];
-    uint8_t y[SNAKE_LEN];
+    uint8_t  lo[SNAKE_RING];
+    uint8_t  hi[SNAKE_RING];
+    uint16_t len;
+    uint8_t  head;
+    uint8_t  head_pg;
+    uint8_t  tail;
+    uint8_t  tail_pg;
+    uint8_t* head_lo;
+    uint8_t* head_hi;
+    uint8_t* tail_lo;
+    uint8_t* tail_hi;
+    uint8_t  hx;
+    uint8_t  hy;
 } Snake;
 
+// Page after 'pg' in the ring (call when a slot index wrapped to 0)
+static inline uint8_t snake_page_next(uint8_t pg) {
+    return (uint8_t)((pg + 1u) & (SNAKE_PAGES - 1u));
+}
+
+// Cell stored at ring position (page, slot)
+static inline Cell snake_cell(const Snake* s, uint8_t pg, uint8_t i) {
+    uint16_t k = ((uint16_t)pg << 8) | i;
+    return ((Cell)s->hi[k] << 8) | s->lo[k];
+}
+
+// Cell of the head segment (through the cached page)
+static inline Cell snake_head_cell(const Snake* s) {
+    uint8_t i = s->head;
+    return ((Cell)s->head_hi[i] << 8) | s->head_lo[i];
+}
+
+// Cell of the tail segment (through the cached page)
+static inline Cell snake_tail_cell(const Snake* s) {
+    uint8_t i = s->tail;
+    return ((Cell)s->tail_hi[i] << 8) | s->tail_lo[i];
+}
+
+// Body walk from tail to head (see snake_walk_next)
+typedef struct {
+    uint8_t pg;
+    uint8_t i;
+} SnakeWalk;
+
+// Start a walk at the tail
+static inline void snake_walk_begin(const Snake* s, SnakeWalk* w) {
+    w->pg = s->tail_pg;
+    w->i  = s->tail;
+}
+
+// Return the current cell and step one segment toward the head
+// (call at most len times)
+static inline Cell snake_walk_next(const Snake* s, SnakeWalk* w) {
+    Cell c = snake_cell(s, w->pg, w->i);
+    if (++w->i == 0) w->pg = snake_page_next(w->pg);
+    return c;
+}
+
+#endif
+
 /* ------------------------------------------------------------
    Core API (used by your game_loop)
 ------------------------------------------------------------ */
@@ -37,44 +184,58 @@ typedef struct {
 // Initialize the snake (centered horizontal body, pointing right)
 void snake_init(Snake* s);
 
+// Initialize a one-segment snake at (x,y) and rebuild the occupancy grid;
+// snake_step_grow() then lays out the rest of the body
+void snake_init_at(Snake* s, uint8_t x, uint8_t y);
+
 // Advance the snake one step in 'dir' with wrap-around.
-// Writes out the tail segment that was removed (for erasing on screen).
-void snake_step(Snake* s, Direction dir,
-                uint8_t* out_tail_x, uint8_t* out_tail_y);
+// Writes out the tail cell that was removed (for erasing on screen).
+void snake_step(Snake* s, Direction dir, Cell* out_tail);
+
+// Write head (x,y) into out parameters without modifying the snake
+void snake_head_xy(const Snake* s, uint8_t* out_x, uint8_t* out_y);
 
-// Return the current head index inside the ring buffer
-static inline uint8_t snake_head_index(const Snake* s) { return s->head; }
+// Cell the head would enter moving one step in 'dir' (wrap-around from the
+// per-direction tables). Does not mutate the snake; used for the collision
+// and eat pre-checks before snake_step()
+Cell snake_next_cell(const Snake* s, Direction dir);
 
-// Compute the next wrapped cell for the current head if we moved in 'dir'.
-// This does not mutate the snake; useful for collision pre-checks before snake_step().
-void snake_next_xy(const Snake* s, Direction dir, uint8_t* out_x, uint8_t* out_y);
+// Neighbour of cell c at column/row (*x,*y) in 'dir' through the same wrap
+// tables; updates *x and *y (for searches over the board)
+Cell snake_cell_step(Cell c, Direction dir, uint8_t* x, uint8_t* y);
 
 // Rebuild the occupancy grid from the current snake body
 void snake_occ_reset_from_body(const Snake* s);
 
-// Test whether (x,y) is occupied by the snake (non-zero if occupied)
-uint8_t snake_occ_test(uint8_t x, uint8_t y);
+// Test whether cell c is occupied by the snake (non-zero if occupied)
+uint8_t snake_occ_test(Cell c);
 
-// Mark (x,y) as occupied in the occupancy grid
-void snake_occ_set(uint8_t x, uint8_t y);
+// Mark cell c as occupied in the occupancy grid
+void snake_occ_set(Cell c);
 
-// Clear (x,y) from the occupancy grid
-void snake_occ_clear(uint8_t x, uint8_t y);
+// Clear cell c from the occupancy grid
+void snake_occ_clear(Cell c);
 
-// Advance the snake with growth (adds a segment; tail is not cleared)
-void snake_step_grow(Snake* s, Direction dir);
+// Number of free cells (not occupied by the snake, not covered by the HUD).
+// The free-cell pool is kept in sync by snake_occ_set/clear in O(1).
+uint16_t snake_free_count(void);
 
-// Compute the current tail index (head - (len-1) modulo SNAKE_LEN)
-unsigned char snake_tail_index(const Snake* s);
+// Free-pool entry k (0 <= k < snake_free_count())
+Cell snake_free_cell(uint16_t k);
 
-// Check if moving to (nx,ny) would cause self-collision (non-zero if yes)
-void snake_compute_next_head_wrap(const Snake* s, Direction dir, unsigned char* nx, unsigned char* ny);
+// Take free cell c out of the pool without marking it occupied (an item such
+// as food sits there), and give it back when the item goes away unclaimed.
+// A cell the snake moves onto is left out: its tail gives it back later.
+void snake_free_take(Cell c);
+void snake_free_give(Cell c);
 
-// Check if (nx,ny) is occupied by the snake body excluding the tail
-unsigned char snake_will_self_collide_next(const Snake* s, unsigned char nx, unsigned char ny);
+// Advance the snake with growth (adds a segment; tail is not cleared)
+void snake_step_grow(Snake* s, Direction dir);
 
-// Return 1 if the snake currently occupies cell (x,y); otherwise return 0
-// Performs a simple linear scan over the snake coordinates
-static uint8_t snake_cell_occupied(const Snake* s, uint8_t x, uint8_t y);
+// Check if moving the head onto cell 'next' collides with the body (non-zero if yes).
+// O(1) occupancy lookup. On a normal step the tail cell is vacated and counts as
+// free; on a grow step (growing != 0, below SNAKE_LEN) the tail stays and blocks.
+unsigned char snake_will_self_collide_next(const Snake* s, Cell next,
+                                           unsigned char growing);
 
 #endif /* SNAKE_H */
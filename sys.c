@@ -1,24 +1,104 @@
-#include <c64.h>
+#include "hal.h"
 #include "sys.h"
 #include "timer.h"
 #include "input.h"
+#include "render.h"
+#include "profile.h"
 
-// Raw VIC-II raster register accessor (simple macro; avoids casts at call sites)
-#define VIC_RASTER  (*((unsigned char*)0xD012))
+#ifdef FRAME_IRQ
+/* --------------------------------------------------------------------
+   Raster IRQ frame engine (build with -DFRAME_IRQ)
+   Experimental: the HAL_IRQ handler is not verified on KickC 0.8.6 or in
+   VICE yet. Raster polling (below) is the supported target engine.
+   - The IRQ fires once per frame in the lower border, ticks the timer
+     and bumps g_irq_frames (the frame-ready flag).
+   - The main loop consumes frames by counting g_seen_frames up to it, so a
+     frame whose logic overruns is caught up on the next call (no lost ticks).
+-------------------------------------------------------------------- */
+// First raster line below the 25 text rows (lower border)
+#define FRAME_IRQ_LINE  0xFB
+
+// Frames signalled by the IRQ (written only by the IRQ)
+static volatile unsigned char g_irq_frames = 0;
+
+// Frames consumed by the main loop (written only by the main loop)
+static unsigned char g_seen_frames = 0;
+
+// Raster IRQ: ack, tick the timer, signal a new frame
+HAL_IRQ void frame_irq(void) {
+    hal_frame_irq_ack();
+    timer_tick_irq();
+    g_irq_frames++;
+}
+
+// Install the raster IRQ (hal.h also silences the CIA1 IRQ)
+void sys_init(void) {
+    g_seen_frames = g_irq_frames;
+    hal_frame_irq_install(&frame_irq, FRAME_IRQ_LINE);
+}
+
+// Wait for the next frame signalled by the IRQ (drops any backlog)
+void wait_frame(void) {
+    unsigned char f = g_irq_frames;
+    while (g_irq_frames == f) hal_frame_idle();
+    g_seen_frames = g_irq_frames;
+#ifdef VICE_CHECK
+    check_frame();
+#endif
+}
+
+// Consume one IRQ frame (returns at once if logic overran), flush the render
+// queue, then read input. The timer was already ticked inside the IRQ
+void frame_sync_and_input(Direction* pdir) {
+    while (g_irq_frames == g_seen_frames) hal_frame_idle();
+    g_seen_frames++;
+#ifdef VICE_CHECK
+    check_frame();
+#endif
+    PROF_BEGIN(PROF_COL_RENDER);
+    render_flush();
+    PROF_BEGIN(PROF_COL_INPUT);
+    input_scan();
+#ifndef AUTOPILOT
+    input_update(pdir);
+#else
+    HAL_UNUSED(pdir);
+#endif
+    PROF_END();
+}
+
+#else
+/* --------------------------------------------------------------------
+   Raster polling frame engine (default)
+-------------------------------------------------------------------- */
+
+// Nothing to install when polling
+void sys_init(void) {
+}
 
 // One frame wait based on raster wrap; also a per-frame “sync + input + timer”
 void wait_frame(void) {
-    while (VIC_RASTER != 0xFF) ;
-    while (VIC_RASTER == 0xFF) ;
+    hal_wait_raster_wrap();
 }
 
-// One frame wait, timer tick, and input update
+// One frame wait, render queue flush (beam is in the lower border), timer tick, and input update
 void frame_sync_and_input(Direction* pdir) {
     wait_frame();
+    PROF_BEGIN(PROF_COL_RENDER);
+    render_flush();
     timer_tick();
+    PROF_BEGIN(PROF_COL_INPUT);
+    input_scan();
+#ifndef AUTOPILOT
     input_update(pdir);
+#else
+    HAL_UNUSED(pdir);
+#endif
+    PROF_END();
 }
 
+#endif
+
 // Blocking wait for a number of frames
 void wait_frames_blocking(unsigned int frames) {
     while (frames != 0u) {
@@ -3,10 +3,16 @@
 
 #include "snake.h"
 
-// One frame wait based on raster wrap
+// Frame engine setup; call once at startup.
+// Default build polls the raster; -DFRAME_IRQ installs a raster IRQ that
+// ticks the timer and signals frames to the main loop.
+void sys_init(void);
+
+// One frame wait based on raster wrap (IRQ mode: next IRQ frame)
 void wait_frame(void);
 
-// One frame wait, timer tick, and input update
+// One frame wait, render queue flush, timer tick, and input update
+// IRQ mode: consumes one pending frame, so overrun frames are caught up
 void frame_sync_and_input(Direction* pdir);
 
 // Blocking wait for a number of frames
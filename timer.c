@@ -4,23 +4,25 @@
 // - Supports both manual and IRQ-based ticking
 // - Detects second “edge” events for once-per-second actions
 
+#include "hal.h"
 #include "timer.h"
-#include <c64.h>
 
 // Frames per second (PAL = 50Hz)
 #define FPS 50
 
+// Counters are volatile: in FRAME_IRQ builds they are written by the raster IRQ
+
 // Total frame counter since last reset
-static unsigned int  g_frames = 0;
+static volatile HAL_ZP unsigned int  g_frames = 0;
 
 // Total seconds elapsed since last reset
-static unsigned int  g_sec    = 0;
+static volatile HAL_ZP unsigned int  g_sec    = 0;
 
 // Frame counter within the current second (0..49)
-static unsigned char g_insec  = 0;
+static volatile HAL_ZP unsigned char g_insec  = 0;
 
 // Rising-edge flag: set once when a new second starts
-static unsigned char g_edge   = 0;
+static volatile HAL_ZP unsigned char g_edge   = 0;
 
 // Reset all timer counters and flags
 void timer_reset(void) {
@@ -54,15 +56,25 @@ void timer_tick_irq(void) {
 }
 
 // Return total number of frames since last reset
-unsigned int timer_frames(void)  { return g_frames; }
+// Re-reads until stable so an IRQ tick between the two bytes cannot tear it
+unsigned int timer_frames(void) {
+    unsigned int f = g_frames;
+    while (f != g_frames) f = g_frames;
+    return f;
+}
 
-// Return total number of elapsed seconds since last reset
-unsigned int timer_seconds(void) { return g_sec; }
+// Return total number of elapsed seconds since last reset (tear-safe, as above)
+unsigned int timer_seconds(void) {
+    unsigned int s = g_sec;
+    while (s != g_sec) s = g_sec;
+    return s;
+}
 
 // Return 1 once per second, then clear the edge flag
 // Useful for triggering events every new second
+// Only clears a set flag, so an IRQ cannot lose an edge between read and clear
 unsigned char timer_second_edge(void) {
     unsigned char e = g_edge;
-    g_edge = 0;
+    if (e) g_edge = 0;
     return e;
 }
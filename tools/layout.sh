@@ -0,0 +1,45 @@
+#!/bin/sh
+# layout.sh <snake.sym>
+# Memory-layout report for the hot game state.
+# Reads the KickAssembler symbol file written by
+#   kickc.bat *.c -t c64 -a -Xassembler=-symbolfile -o snake.prg
+# and prints, for each hot symbol, its address and placement: zero page (ZP)
+# or page start (PAGE). Tables of up to one page that straddle a page boundary
+# are flagged (every indexed read then pays a cycle). Symbols the compiler
+# folded away are reported missing.
+
+set -eu
+
+SYM=$1
+
+# name:size pairs (size 0 = scalar, only the placement is checked)
+HOT="g_snake:2064 g_occ:125 g_free_cell:2000 g_free_pos:2000
+g_free_n:0 g_food_at:1000 BIT:8 NBIT:8 row_off:50 DIG_TENS:100 DIG_ONES:100
+rq_off:64 rq_ch:32 rq_col:32 rq_n:0 g_held:0 g_pressed:0
+g_frames:0 g_sec:0 g_insec:0 g_edge:0 move_acc:0 move_rate:0"
+
+printf '%-12s %6s %-5s %s\n' SYMBOL ADDR PLACE NOTE
+for e in $HOT; do
+    name=${e%%:*}
+    size=${e##*:}
+    # ".label name=$xxxx" (first match, any namespace)
+    hex=$(sed -n "s/^[[:space:]]*\.label[[:space:]]*$name[[:space:]]*=[[:space:]]*\\\$\([0-9a-fA-F]*\).*/\1/p" "$SYM" | head -n 1)
+    if [ -z "$hex" ]; then
+        printf '%-12s %6s %-5s %s\n' "$name" - - missing
+        continue
+    fi
+    addr=$((0x$hex))
+    if [ "$addr" -lt 256 ]; then
+        place=ZP
+    elif [ $((addr & 255)) -eq 0 ]; then
+        place=PAGE
+    else
+        place=-
+    fi
+    note=
+    if [ "$size" -gt 0 ] && [ "$size" -le 256 ] &&
+       [ $((addr >> 8)) -ne $(((addr + size - 1) >> 8)) ]; then
+        note="crosses page"
+    fi
+    printf '%-12s  $%04x %-5s %s\n' "$name" "$addr" "$place" "$note"
+done
@@ -0,0 +1,244 @@
+// mkscreens.c
+// Build step for the packed screens: converts screen layouts (assets/*.txt)
+// into run-length coded screen-code and colour streams for render.c.
+//
+//   mkscreens <out> <layout.txt>...
+//
+// Writes <out>.c (one SCR_<NAME> array per layout, NAME from the file name)
+// and <out>.h (their declarations). host/Makefile runs it: make -C host screens
+//
+// Layout file:
+//   ; comment
+//   fill <char> <colour>   cells not given take this screen code and colour;
+//   fill keep              ... or are left as they are (overlays)
+//   screen                 up to 25 text lines follow (uppercase ASCII,
+//                          converted to screen codes here); '~' keeps a cell
+//   colour                 up to 25 lines follow, one hex digit per cell;
+//                          '.' is the fill colour, '~' keeps a cell
+//
+// Stream format (one for the screen codes, then one for the colours):
+//   $01-$7F n   n literal bytes follow
+//   $81-$FF n   the next byte, repeated n & $7F times
+//   $80 n       skip n cells (n = 1..255)
+//   $00         end of stream
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define COLS  40
+#define ROWS  25
+#define CELLS (COLS*ROWS)
+
+// Cell value that leaves the screen as it is
+#define KEEP  -1
+
+// One decoded layout
+typedef struct {
+    char name[64];
+    int  scr[CELLS];
+    int  col[CELLS];
+} Layout;
+
+// ASCII (uppercase) -> C64 screen code
+static int ascii_to_screen(int ch) {
+    if (ch >= 'A' && ch <= 'Z') return ch - 'A' + 1;
+    if (ch >= 'a' && ch <= 'z') return ch - 'a' + 1;
+    if (ch == '@') return 0;
+    return ch;
+}
+
+static int hex_digit(int ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    ch = toupper(ch);
+    if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+    return -1;
+}
+
+// Layout name from the file name: "assets/game_over.txt" -> "GAME_OVER"
+static void layout_name(const char* path, char* out, size_t n) {
+    const char* base = strrchr(path, '/');
+    size_t i = 0;
+    base = base ? base + 1 : path;
+    while (base[i] && base[i] != '.' && i + 1 < n) {
+        out[i] = (char)(isalnum((unsigned char)base[i]) ? toupper((unsigned char)base[i]) : '_');
+        i++;
+    }
+    out[i] = 0;
+}
+
+static int load_layout(const char* path, Layout* l) {
+    FILE* f = fopen(path, "r");
+    char line[256];
+    int fill_ch = 32, fill_col = 6, keep = 0;
+    int section = 0, row = 0, lineno = 0;
+    int text[ROWS][COLS], colour[ROWS][COLS];
+
+    if (!f) {
+        perror(path);
+        return 0;
+    }
+    layout_name(path, l->name, sizeof(l->name));
+
+    // -2: not given yet (fill applies at the end)
+    for (int y = 0; y < ROWS; y++) {
+        for (int x = 0; x < COLS; x++) {
+            text[y][x] = -2;
+            colour[y][x] = -2;
+        }
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        size_t len = strcspn(line, "\r\n");
+        line[len] = 0;
+        lineno++;
+        if (line[0] == ';') continue;
+
+        if (section == 0 || strcmp(line, "screen") == 0 || strcmp(line, "colour") == 0) {
+            if (strncmp(line, "fill ", 5) == 0) {
+                if (strcmp(line + 5, "keep") == 0) {
+                    keep = 1;
+                } else if (sscanf(line + 5, "%i %i", &fill_ch, &fill_col) != 2) {
+                    fprintf(stderr, "%s:%d: fill <char> <colour> or fill keep\n", path, lineno);
+                    fclose(f);
+                    return 0;
+                }
+                continue;
+            }
+            if (strcmp(line, "screen") == 0) { section = 1; row = 0; continue; }
+            if (strcmp(line, "colour") == 0) { section = 2; row = 0; continue; }
+            if (line[0] == 0) continue;
+            fprintf(stderr, "%s:%d: unexpected '%s'\n", path, lineno, line);
+            fclose(f);
+            return 0;
+        }
+
+        if (row >= ROWS || len > COLS) {
+            fprintf(stderr, "%s:%d: layout is 40x25\n", path, lineno);
+            fclose(f);
+            return 0;
+        }
+        for (size_t x = 0; x < len; x++) {
+            int ch = (unsigned char)line[x];
+            if (section == 1) {
+                text[row][x] = (ch == '~') ? KEEP : ascii_to_screen(ch);
+            } else if (ch == '~') {
+                colour[row][x] = KEEP;
+            } else if (ch != '.') {
+                colour[row][x] = hex_digit(ch);
+                if (colour[row][x] < 0) {
+                    fprintf(stderr, "%s:%d: colour is a hex digit, '.' or '~'\n", path, lineno);
+                    fclose(f);
+                    return 0;
+                }
+            }
+        }
+        row++;
+    }
+    fclose(f);
+
+    // Cells not given take the fill; a kept screen cell keeps its colour too
+    for (int y = 0; y < ROWS; y++) {
+        for (int x = 0; x < COLS; x++) {
+            int i = y * COLS + x;
+            int t = text[y][x];
+            int c = colour[y][x];
+            if (t == -2) t = keep ? KEEP : fill_ch;
+            if (c == -2) c = keep ? KEEP : fill_col;
+            if (t == KEEP) c = KEEP;
+            if (c == KEEP && !keep) c = fill_col;
+            l->scr[i] = t;
+            l->col[i] = c;
+        }
+    }
+    return 1;
+}
+
+// Run-length code one stream of CELLS values; returns its length in bytes
+static int pack(const int* v, unsigned char* out) {
+    int n = 0, i = 0;
+    while (i < CELLS) {
+        int run = 1;
+        while (i + run < CELLS && v[i + run] == v[i]) run++;
+
+        if (v[i] == KEEP) {
+            if (run > 255) run = 255;
+            out[n++] = 0x80;
+            out[n++] = (unsigned char)run;
+            i += run;
+        } else if (run >= 3) {
+            if (run > 127) run = 127;
+            out[n++] = (unsigned char)(0x80 | run);
+            out[n++] = (unsigned char)v[i];
+            i += run;
+        } else {
+            // Literals up to the next run of three or a kept cell
+            int start = i, lit = 0;
+            while (i < CELLS && lit < 127 && v[i] != KEEP &&
+                   !(i + 2 < CELLS && v[i] == v[i + 1] && v[i] == v[i + 2])) {
+                i++;
+                lit++;
+            }
+            out[n++] = (unsigned char)lit;
+            for (int k = 0; k < lit; k++) out[n++] = (unsigned char)v[start + k];
+        }
+    }
+    out[n++] = 0x00;
+    return n;
+}
+
+static void emit_bytes(FILE* f, const unsigned char* b, int n) {
+    for (int i = 0; i < n; i++) {
+        fprintf(f, "%s0x%02x,", (i % 12) == 0 ? "\n    " : " ", b[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    char path[512];
+    FILE* fc;
+    FILE* fh;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: mkscreens <out> <layout.txt>...\n");
+        return 1;
+    }
+
+    snprintf(path, sizeof(path), "%s.c", argv[1]);
+    fc = fopen(path, "w");
+    if (!fc) { perror(path); return 1; }
+    snprintf(path, sizeof(path), "%s.h", argv[1]);
+    fh = fopen(path, "w");
+    if (!fh) { perror(path); return 1; }
+
+    fprintf(fh, "#ifndef SCREENS_H\n#define SCREENS_H\n\n");
+    fprintf(fh, "// screens.h\n// Packed screens, generated by tools/mkscreens.c from assets/*.txt.\n");
+    fprintf(fh, "// Do not edit: change the layouts and run make -C host screens.\n");
+    fprintf(fh, "// Each is a screen-code stream then a colour stream (format in mkscreens.c)\n\n");
+    fprintf(fc, "// screens.c\n// Packed screens, generated by tools/mkscreens.c from assets/*.txt.\n");
+    fprintf(fc, "// Do not edit: change the layouts and run make -C host screens.\n\n");
+    fprintf(fc, "#include \"screens.h\"\n");
+
+    for (int a = 2; a < argc; a++) {
+        static Layout l;
+        static unsigned char s[2 * CELLS + 4], c[2 * CELLS + 4];
+        const char* base = strrchr(argv[a], '/');
+        int ns, nc;
+        if (!load_layout(argv[a], &l)) return 1;
+        base = base ? base + 1 : argv[a];
+        ns = pack(l.scr, s);
+        nc = pack(l.col, c);
+
+        fprintf(fh, "// assets/%s: %d + %d bytes\n", base, ns, nc);
+        fprintf(fh, "extern const unsigned char SCR_%s[%d];\n\n", l.name, ns + nc);
+        fprintf(fc, "\nconst unsigned char SCR_%s[%d] = {", l.name, ns + nc);
+        emit_bytes(fc, s, ns);
+        emit_bytes(fc, c, nc);
+        fprintf(fc, "\n};\n");
+    }
+
+    fprintf(fh, "#endif\n");
+    fclose(fc);
+    fclose(fh);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/bin/sh
+# progend.sh <snake.prg> [limit]
+# Program-end guard. Prints the address range a PRG loads into (load address
+# from its first two bytes, then code and data: KickC emits the uninitialised
+# variables into the PRG too) and fails if it reaches 'limit'.
+# The default limit is $8000, where -DSCREEN_DOUBLE puts its two screens and
+# the sprite image ($8000-$88FF); pass e.g. 0xC000 for the VICE check block.
+
+set -eu
+
+PRG=$1
+LIMIT=$(( ${2:-0x8000} ))
+
+SIZE=$(wc -c < "$PRG")
+LOAD=$(od -An -tu2 -N2 "$PRG" | tr -d ' ')
+END=$((LOAD + SIZE - 2))
+
+printf 'program $%04x-$%04x (limit $%04x)\n' "$LOAD" $((END - 1)) "$LIMIT"
+if [ "$END" -gt "$LIMIT" ]; then
+    printf 'FAIL: program overlaps $%04x by %d bytes\n' "$LIMIT" $((END - LIMIT))
+    exit 1
+fi
@@ -0,0 +1,76 @@
+#!/bin/sh
+# check.sh <prg> [--record]
+# Runs a -DVICE_CHECK build in x64sc without a window and at full speed.
+# The PRG exits through the debug cartridge ($D7FF) after CHECK_FRAMES; a
+# monitor watchpoint on that store saves the dump block ($C000-$C7FF, see
+# check.h) first. Prints the measured cycles and compares screen + colour RAM
+# against golden/screen.bin (or records it with --record).
+
+set -eu
+
+PRG=$1
+MODE=${2:-}
+X64SC=${X64SC:-x64sc}
+LIMITCYCLES=${LIMITCYCLES:-200000000}
+OUT=out
+
+mkdir -p "$OUT"
+rm -f "$OUT/dump.bin"
+
+cat > "$OUT/mon.txt" <<MON
+watch store \$d7ff
+command 1 "bsave \"$OUT/dump.bin\" 0 c000 c7ff"
+MON
+
+set +e
+"$X64SC" -console -warp -silent -sounddev dummy \
+    -debugcart -limitcycles "$LIMITCYCLES" \
+    -moncommands "$OUT/mon.txt" \
+    -autostartprgmode 1 -autostart "$PRG" >"$OUT/vice.log" 2>&1
+RC=$?
+set -e
+
+if [ "$RC" -ne 0 ] || [ ! -f "$OUT/dump.bin" ]; then
+    echo "FAIL: x64sc exit code $RC (1 = cycle limit hit), see $OUT/vice.log"
+    exit 1
+fi
+
+# bsave writes raw memory (no load address), so the dump is exactly
+# $C000-$C7FF; any other size means the offsets below would be wrong
+SIZE=$(wc -c < "$OUT/dump.bin")
+if [ "$SIZE" -ne 2048 ]; then
+    echo "FAIL: dump.bin is $SIZE bytes, expected 2048 (raw \$C000-\$C7FF)"
+    exit 1
+fi
+
+# Screen + colour RAM (2000 bytes) is the regression image; the result block
+# follows it
+head -c 2000 "$OUT/dump.bin" > "$OUT/screen.bin"
+tail -c +2001 "$OUT/dump.bin" | head -c 10 > "$OUT/result.bin"
+
+if [ "$(head -c 4 "$OUT/result.bin")" != "SNK1" ]; then
+    echo "FAIL: result block magic missing"
+    exit 1
+fi
+
+FRAMES=$(od -An -tu2 -j4 -N2 "$OUT/result.bin" | tr -d ' ')
+CYCLES=$(od -An -tu4 -j6 -N4 "$OUT/result.bin" | tr -d ' ')
+echo "frames $FRAMES cycles $CYCLES ($((CYCLES / FRAMES)) per frame)"
+
+if [ "$MODE" = "--record" ]; then
+    cp "$OUT/screen.bin" golden/screen.bin
+    echo "recorded golden/screen.bin"
+    exit 0
+fi
+
+if [ ! -f golden/screen.bin ]; then
+    echo "FAIL: no golden/screen.bin (run: make golden)"
+    exit 1
+fi
+
+if cmp -s "$OUT/screen.bin" golden/screen.bin; then
+    echo "PASS: screen matches golden"
+else
+    echo "FAIL: screen differs from golden/screen.bin"
+    exit 1
+fi